@@ -14,6 +14,9 @@
 // #include "src/app/AttitudeBenchmark.h"
 // App* app = new AttitudeBenchmark();
 
+// #include "src/app/EepromBenchmark.h"
+// App* app = new EepromBenchmark();
+
 #include "src/app/Bittleet.h"
 App* app = new Bittleet();
 
@@ -14,5 +14,9 @@
 #define DOF 16 // TODO - we can only map up to 12 servos - find out what this is used for...
 #define WALKING_DOF 8
 
+// Largest instincts in the Bittle skill image. Skill storage is sized from these.
+#define MAX_GAIT_FRAMES 52
+#define MAX_BEHAVIOUR_FRAMES 20
+
 
 #endif // _BITTLEET_BITTLE_H_
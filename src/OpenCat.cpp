@@ -43,10 +43,10 @@ static bool restQ = false;
 // called this way, it uses the default address 0x40
 Adafruit_PWMServoDriver pwm = Adafruit_PWMServoDriver();
 
-ServoRange servoRange[DOF] = {};
+Servo::Calibration servoCalibration(SERVOMIN, SERVOMAX);
+Servo::Frame servoFrame;
 int16_t currentAng[DOF] = {};
 AdjustAngle currentAdjust[DOF] = {};
-int16_t calibratedDuty0[DOF] = {};
 
 float postureOrWalkingFactor;
 
@@ -54,13 +54,6 @@ float rollDeviation;
 float pitchDeviation;
 
 
-float pulsePerDegreeF(int i) {
-  if (i >= DOF) {
-    return 0.0f;
-  }
-  return float(PWM_RANGE) / servoRange[i].toF32();
-}
-
 void beep(int8_t note, float duration, int pause, byte repeat) {
   if (note == 0) {//rest note
     analogWrite(BUZZER, 0);
@@ -145,6 +138,7 @@ void copyDataFromPgmToI2cEeprom(unsigned int &eeAddress, unsigned int pgmAddress
 #ifdef BUZZER
         meow(3);
 #endif
+        Skill::I2cEeprom::invalidate();
         return;
       }
       /*PT((int8_t)pgm_read_byte(pgmAddress + writtenToEE));
@@ -158,6 +152,7 @@ void copyDataFromPgmToI2cEeprom(unsigned int &eeAddress, unsigned int pgmAddress
     delay(6);  // needs 5ms for page write
     //PTL("\nwrote " + String(writtenToWire) + " bytes.");
   }
+  Skill::I2cEeprom::invalidate();
   //PTLF("finish copying to I2C EEPROM");
 }
 
@@ -195,41 +190,46 @@ float adjust(byte i) {
     if ((leftQ && rollDeviation > 0 ) || ( !leftQ && rollDeviation < 0)) {
       leftRightFactor = LEFT_RIGHT_FACTOR;
     }
-    rollAdj = fabs(rollDeviation) * adaptiveCoefficient(i, 0) * leftRightFactor;
+    rollAdj = fabs(rollDeviation) * servoCalibration.joint(i).adaptive[0] * leftRightFactor;
   }
   else {
-    rollAdj = rollDeviation * adaptiveCoefficient(i, 0);
+    rollAdj = rollDeviation * servoCalibration.joint(i).adaptive[0];
   }
   currentAdjust[i] = M_DEG2RAD * (
-                       (i > 3 ? postureOrWalkingFactor : 1.0f) * rollAdj - adaptiveCoefficient(i, 1) * pitchDeviation);
+                       (i > 3 ? postureOrWalkingFactor : 1.0f) * rollAdj - servoCalibration.joint(i).adaptive[1] * pitchDeviation);
   return currentAdjust[i].toF32();
 }
 
 void saveCalib(int8_t *var) {
   for (byte i = 0; i < DOF; i++) {
-    EEPROM.update(CALIB + i, var[i]);
-    calibratedDuty0[i] = SERVOMIN + PWM_RANGE / 2 + float(middleShift(i) + var[i]) * pulsePerDegreeF(i) * rotationDirection(i);
+    servoCalibration.setCalib(i, var[i]);
   }
+  servoCalibration.save();
 }
 
 void calibratedPWM(byte i, float angle) {
   currentAng[i] = angle;
-  int duty = calibratedDuty0[i] + angle * pulsePerDegreeF(i) * rotationDirection(i);
-  duty = max(SERVOMIN , min(SERVOMAX , duty));
-  pwm.setPWM(pin(i), 0, duty);
+  servoFrame.set(servoCalibration.joint(i).pin, servoCalibration.duty(i, angle));
+}
+
+void calibratedPWM(byte i, Servo::Angle angle) {
+  currentAng[i] = angle.truncate();
+  servoFrame.set(servoCalibration.joint(i).pin, servoCalibration.duty(i, angle));
 }
 
 void allCalibratedPWM(char * dutyAng, byte offset) {
   for (int8_t i = DOF - 1; i >= offset; i--) {
-    calibratedPWM(i, dutyAng[i]);
+    calibratedPWM(i, Servo::Angle::fromInt(dutyAng[i]));
   }
+  servoFrame.commit();
 }
 
 void shutServos() {
   delay(100);
   for (int8_t i = DOF - 1; i >= 0; i--) {
-    pwm.setPWM(i, 0, 4096);
+    servoFrame.set(i, PCA9685_FULL_OFF);
   }
+  servoFrame.commit();
 }
 
 
@@ -74,6 +74,10 @@
 #include "command/Command.h" //activate the correct header file according to your model
 #include "math/Trig.h"
 #include "math/FixedPoint.h"
+#include "skill/I2cEeprom.h"
+#include "servo/Calibration.h"
+#include "servo/Frame.h"
+#include "servo/Trajectory.h"
 
 #define NyBoard_V1_0
 
@@ -124,19 +128,13 @@ Adafruit_NeoPixel pixels(NUMPIXELS, PIXEL_PIN, NEO_GRB + NEO_KHZ800);
 
 //on-board EEPROM addresses
 #define MELODY 1023 //melody will be saved at the end of the 1KB EEPROM, and is read reversely. That allows some flexibility on the melody length. 
-#define PIN 0                 // 16 byte array
-#define CALIB 16              // 16 byte array
-#define MID_SHIFT 32          // 16 byte array
-#define ROTATION_DIRECTION 48 // 16 byte array
-#define SERVO_ANGLE_RANGE 64  // 16 byte array
+// PIN, CALIB, MID_SHIFT, ROTATION_DIRECTION, SERVO_ANGLE_RANGE and ADAPT_PARAM are in servo/Calibration.h
 #define MPUCALIB 80           // 16 byte array
 #define FAST 96               // 16 byte array
 #define SLOW 112              // 16 byte array
 #define LEFT 128              // 16 byte array
 #define RIGHT 144             // 16 byte array
 
-#define ADAPT_PARAM 160          // 16 x NUM_ADAPT_PARAM byte array
-#define NUM_ADAPT_PARAM  2    // number of parameters for adaption
 #define SKILLS 200         // 1 byte for skill name length, followed by the char array for skill name
 // then followed by i(nstinct) on progmem, or n(ewbility) on progmem
 
@@ -180,12 +178,11 @@ extern Adafruit_PWMServoDriver pwm;
 #define PWM_RANGE (SERVOMAX - SERVOMIN)
 
 typedef FixedPoint<int16_t, 8> AdjustAngle;
-typedef FixedPoint<uint8_t, 0> ServoRange;
 
-extern ServoRange servoRange[DOF];
+extern Servo::Calibration servoCalibration;
+extern Servo::Frame servoFrame; // calibratedPWM only buffers, commit once per tick
 extern int16_t currentAng[DOF];
 extern AdjustAngle currentAdjust[DOF];
-extern int calibratedDuty0[DOF];
 
 
 extern float rollDeviation;
@@ -194,8 +191,6 @@ extern float pitchDeviation;
 
 //--------------------
 
-float pulsePerDegreeF(int i);
-
 //This function will write a 2 byte integer to the eeprom at the specified address and address + 1
 void EEPROMWriteInt(int p_address, int p_value);
 
@@ -270,25 +265,20 @@ class Motion {
       }
     }
     void loadDataFromI2cEeprom(unsigned int &eeAddress) {
-      Wire.beginTransmission(DEVICE_ADDRESS);
-      Wire.write((int)((eeAddress) >> 8));   // MSB
-      Wire.write((int)((eeAddress) & 0xFF)); // LSB
-      Wire.endTransmission();
       byte skillHeader = 4;
-      Wire.requestFrom((int)DEVICE_ADDRESS, (int)skillHeader);
-      period = Wire.read();
+      char header[4];
+      Skill::I2cEeprom::read(eeAddress, header, skillHeader);
+      period = header[0];
       //PTL("read " + String(period) + " frames");
       for (int i = 0; i < 2; i++)
-        expectedRollPitch[i] = (int8_t)Wire.read();
-      angleDataRatio = Wire.read();
+        expectedRollPitch[i] = (int8_t)header[1 + i];
+      angleDataRatio = header[3];
 
       byte frameSize;
       if (period < -1) {
         skillHeader = 7;
         frameSize = 20;
-        Wire.requestFrom(DEVICE_ADDRESS, 3);
-        for (byte i = 0; i < 3; i++)
-          loopCycle[i] = Wire.read();
+        Skill::I2cEeprom::read(eeAddress + 4, (char*)loopCycle, 3);
       }
       else
         frameSize = period > 1 ? WALKING_DOF : 16;
@@ -296,20 +286,7 @@ class Motion {
       //delete []dutyAngles;//check here
 
       dutyAngles = new char[len];
-
-      int readFromEE = 0;
-      int readToWire = 0;
-      while (len > 0) {
-        //PTL("request " + String(min(WIRE_BUFFER, len)));
-        Wire.requestFrom(DEVICE_ADDRESS, min(WIRE_BUFFER, len));
-        readToWire = 0;
-        do {
-          if (Wire.available()) dutyAngles[readFromEE++] = Wire.read();
-          /*PT( (int8_t)dutyAngles[readFromEE - 1]);
-            PT('\t')*/
-        } while (--len > 0 && ++readToWire < WIRE_BUFFER);
-        //PTL();
-      }
+      Skill::I2cEeprom::read(eeAddress + skillHeader, dutyAngles, len);
       //PTLF("finish reading");
     }
 
@@ -434,25 +411,9 @@ class Motion {
 
 void assignSkillAddressToOnboardEeprom();
 
-inline byte pin(byte idx) {
-  return EEPROM.read(PIN + idx);
-}
 inline byte remapPin(byte offset, byte idx) {
   return EEPROM.read(offset + idx);
 }
-inline byte servoAngleRange(byte idx) {
-  return EEPROM.read(SERVO_ANGLE_RANGE + idx);
-}
-inline int8_t middleShift(byte idx) {
-  return EEPROM.read( MID_SHIFT + idx);
-}
-
-inline int8_t rotationDirection(byte idx) {
-  return EEPROM.read(ROTATION_DIRECTION + idx);
-}
-inline int8_t servoCalib(byte idx) {
-  return EEPROM.read( CALIB + idx);
-}
 
 // balancing parameters
 #define ROLL_LEVEL_TOLERANCE 0.25
@@ -477,65 +438,17 @@ inline int8_t servoCalib(byte idx) {
 extern float postureOrWalkingFactor;
 
 
-inline int8_t adaptiveCoefficient(byte idx, byte para) {
-  return EEPROM.read(ADAPT_PARAM + idx * NUM_ADAPT_PARAM + para);
-}
-
 float adjust(byte i);
 
 void saveCalib(int8_t *var);
 
 void calibratedPWM(byte i, float angle);
+void calibratedPWM(byte i, Servo::Angle angle);
 
 void allCalibratedPWM(char * dutyAng, byte offset = 0);
 
 void shutServos();
 
-template <typename T> void moveToPose( T * target, byte angleDataRatio = 1, float degreesPerStep = 1, byte offset = 0) {
-  if (degreesPerStep == 0) { // No speed limiting
-    allCalibratedPWM(target, 8);
-  } else {
-    int *diff = new int [DOF - offset], maxDiff = 0;
-    for (byte i = offset; i < DOF; i++) {
-      diff[i - offset] =   currentAng[i] - target[i - offset] * angleDataRatio;
-      maxDiff = max(maxDiff, abs( diff[i - offset]));
-    }
-
-    byte steps = byte(round(maxDiff / degreesPerStep));
-
-    for (byte s = 0; s <= steps; s++) {
-      for (byte i = offset; i < DOF; i++) {
-        float dutyAng = (target[i - offset] * angleDataRatio + (steps == 0 ? 0 : (1 + cos(M_PI * s / steps)) / 2 * diff[i - offset]));
-        calibratedPWM(i,  dutyAng);
-      }
-    }
-    delete [] diff;
-  }
-}
-
-template <typename T> void transform( T * target, byte angleDataRatio = 1, float speedRatio = 1, byte offset = 0) {
-  if (speedRatio == 0) { // No speed limiting
-    allCalibratedPWM(target, 8);
-  } else {
-    int *diff = new int [DOF - offset], maxDiff = 0;
-    for (byte i = offset; i < DOF; i++) {
-      diff[i - offset] =   currentAng[i] - target[i - offset] * angleDataRatio;
-      maxDiff = max(maxDiff, abs( diff[i - offset]));
-    }
-
-    byte steps = byte(round(maxDiff / 1.0/*degreeStep*/ / speedRatio));//default speed is 1 degree per step
-
-    for (byte s = 0; s <= steps; s++) {
-      for (byte i = offset; i < DOF; i++) {
-        float dutyAng = (target[i - offset] * angleDataRatio + (steps == 0 ? 0 : (1 + cos(M_PI * s / steps)) / 2 * diff[i - offset]));
-        calibratedPWM(i,  dutyAng);
-      }
-    }
-    delete [] diff;
-  }
-}
-
-
 
 
 //short tools
@@ -544,6 +457,7 @@ template <typename T> void allCalibratedPWM(T * dutyAng, byte offset = 0) {
   for (int8_t i = DOF - 1; i >= offset; i--) {
     calibratedPWM(i, dutyAng[i]);
   }
+  servoFrame.commit();
 }
 
 template <typename T> int8_t sign(T val) {
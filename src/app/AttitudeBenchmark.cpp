@@ -9,13 +9,20 @@
 
 #include "AttitudeBenchmark.h"
 #include "../state/Attitude.h"
+#include "../state/Dmp.h"
+#include "DmpReader.h"
 
 #include "../3rdParty/I2Cdev/I2Cdev.h"
 #include "../3rdParty/MPU6050/MPU6050.h"
 #include "../OpenCat.h"
+#include "../math/Trig.h"
 
+// The DMP runs the gyro at 2000 deg/s full scale, the complementary filter expects 1000 deg/s.
+#define GYRO_SCALE_TO_FILTER (2)
+#define AVERAGE_WEIGHT (1.0f / 64.0f)
+#define CYCLES_PER_US (F_CPU / 1000000L)
 
-static MPU6050 mpu;
+static MPU6050& mpu = DmpReader::mpu();
 
 static void initI2C() {
   Wire.begin();
@@ -30,52 +37,84 @@ void AttitudeBenchmark::setup() {
   mpu.initialize();
   Serial.println(mpu.testConnection() ? "MPU6050 connection successful" : "MPU6050 connection failed");
 
+  // Both providers run off the same samples: the DMP from its FIFO, the filter from the raw registers.
+  Serial.println(DmpReader::begin() ? "DMP started" : "DMP failed to start");
+
   mpu.setZAccelOffset(EEPROMReadInt(MPUCALIB + 4));
   mpu.setXGyroOffset(EEPROMReadInt(MPUCALIB + 6));
   mpu.setYGyroOffset(EEPROMReadInt(MPUCALIB + 8));
   mpu.setZGyroOffset(EEPROMReadInt(MPUCALIB + 10));
-    
-  mpu.setDLPFMode(2); // Effectively 100Hz bandwidth for gyra and accel
-  mpu.setFullScaleAccelRange(MPU6050_ACCEL_FS_2); // Don't need anything beyond 2g
-  mpu.setFullScaleGyroRange(MPU6050_GYRO_FS_1000); 
+}
+
+static void printAngles(const char* name, uint32_t us, float averageUs, const Attitude::Provider& provider) {
+  Serial.print(name);
+  Serial.print(" us: ");
+  Serial.print(us);
+  Serial.print(" (avg ");
+  Serial.print(averageUs);
+  Serial.print(", cycles ");
+  Serial.print((uint32_t)(averageUs * CYCLES_PER_US));
+  Serial.print(")\troll: ");
+  Serial.print(provider.roll() * M_RAD2DEG);
+  Serial.print("\tpitch: ");
+  Serial.print(provider.pitch() * M_RAD2DEG);
+  Serial.print("\t");
 }
 
 void AttitudeBenchmark::loop() {
-  static Attitude::Attitude attitude{};
+  static Attitude::Attitude filter{};
+  static Attitude::AttitudeFixed fixed{};
+  static Attitude::Dmp dmp{true};
+  static float filterAverageUs = 0.0f;
+  static float fixedAverageUs = 0.0f;
+  static float dmpAverageUs = 0.0f;
+  static float rollDiffAverage = 0.0f;
+  static float pitchDiffAverage = 0.0f;
+  static uint32_t dmpUs = 0;
   delay(10);
-  uint32_t dt = micros();
 
+  Attitude::Quaternion q;
+  if (DmpReader::read(q)) {
+    dmpUs = micros();
+    dmp.update(q);
+    dmpUs = micros() - dmpUs;
+    dmpAverageUs += (dmpUs - dmpAverageUs) * AVERAGE_WEIGHT;
+  }
 
   Attitude::Measurement m;
-  m.us = micros();
   mpu.getMotion6(&m.accel.x, &m.accel.y, &m.accel.z, &m.gyro.x, &m.gyro.y, &m.gyro.z);
+  m.us = micros();
   m.accel.x = -m.accel.x;
   m.accel.y = -m.accel.y;
-  m.gyro.x = -m.gyro.x;
-  m.gyro.y = -m.gyro.y;
+  m.gyro.x = -m.gyro.x * GYRO_SCALE_TO_FILTER;
+  m.gyro.y = -m.gyro.y * GYRO_SCALE_TO_FILTER;
 
-  attitude.update(m);
-  dt = micros() - dt;
+  uint32_t filterUs = micros();
+  filter.update(m);
+  filterUs = micros() - filterUs;
+  filterAverageUs += (filterUs - filterAverageUs) * AVERAGE_WEIGHT;
 
-  Serial.print("dt (us): ");
-  Serial.print(dt);
-  Serial.print("\t");
-  Serial.print("roll: ");
-  Serial.print(attitude.roll());
-  Serial.print("\t");
-  Serial.print("pitch: ");
-  Serial.print(attitude.pitch());
-  Serial.print("\t");
-  Serial.print("ax: ");
-  Serial.print(m.accel.x);
-  Serial.print("\t");
-  Serial.print("ay: ");
-  Serial.print(m.accel.y);
-  Serial.print("\t");
-  Serial.print("az: ");
-  Serial.print(m.accel.z);
-  Serial.print("\n");
+  uint32_t fixedUs = micros();
+  fixed.update(m);
+  fixedUs = micros() - fixedUs;
+  fixedAverageUs += (fixedUs - fixedAverageUs) * AVERAGE_WEIGHT;
 
-  Serial.print("\n");
+  // Neither is ground truth, so accuracy is how far apart they are
+  const float rollDiff = fabs(shortestRadianPath(filter.roll(), dmp.roll())) * M_RAD2DEG;
+  const float pitchDiff = fabs(shortestRadianPath(filter.pitch(), dmp.pitch())) * M_RAD2DEG;
+  rollDiffAverage += (rollDiff - rollDiffAverage) * AVERAGE_WEIGHT;
+  pitchDiffAverage += (pitchDiff - pitchDiffAverage) * AVERAGE_WEIGHT;
 
+  printAngles("filter", filterUs, filterAverageUs, filter);
+  printAngles("fixed", fixedUs, fixedAverageUs, fixed);
+  printAngles("dmp", dmpUs, dmpAverageUs, dmp);
+  Serial.print("diff roll: ");
+  Serial.print(rollDiff);
+  Serial.print(" (avg ");
+  Serial.print(rollDiffAverage);
+  Serial.print(")\tpitch: ");
+  Serial.print(pitchDiff);
+  Serial.print(" (avg ");
+  Serial.print(pitchDiffAverage);
+  Serial.print(")\n");
 }
@@ -44,14 +44,33 @@
 #include "../ui/Comms.h"
 #include "../ui/Infrared.h"
 
+// #define ATTITUDE_DMP // Fuse on the MPU6050's DMP instead of the complementary filter
+
+#include "../state/Provider.h"
+#include "DmpReader.h" // Defines the MPU6050, even without the DMP
+#ifdef ATTITUDE_DMP
+#include "../state/Dmp.h"
+#else
 #include "../state/Attitude.h"
+#include "../state/ImuFifo.h"
+#include "../state/DataReady.h"
+#endif
 
 #include "../skill/Skill.h"
 #include "../skill/LoaderEeprom.h"
+#include "../skill/GaitStream.h"
+#include "../skill/LoaderCached.h"
+#include "../skill/LoaderProgmem.h"
+#include "../skill/LoaderComposite.h"
+#include "../skill/Predictor.h"
+#include "../skill/Behaviour.h"
+#include "../skill/Sequencer.h"
+#include "../skill/Crossfade.h"
 
 #include "../scheduler/Scheduler.h"
+#include "../command/Queue.h"
 
-static MPU6050 mpu;
+static MPU6050& mpu = DmpReader::mpu();
 
 // NeoPixel integration
 #define PIXEL_PIN 10
@@ -59,6 +78,7 @@ static MPU6050 mpu;
 Adafruit_NeoPixel pixels(PIXEL_PIN, PIXEL_COUNT, NEO_GRB + NEO_KHZ800);
 
 #define BAUD_RATE 115200
+#define STATS_PERIOD_US (1000000UL)
 
 
 
@@ -78,32 +98,153 @@ static int8_t servoCalibs[DOF] = {};
 
 static Skill::Skill skill;
 static Skill::Loader* loader;
+static Skill::LoaderEeprom* eepromLoader;
+static Skill::LoaderCached* cachedLoader;
+static Skill::LoaderProgmem* progmemLoader;
+static Skill::LoaderComposite* compositeLoader;
+static Skill::GaitStream gaitStream;
+static bool skillLoading = false; // The skill must not be played until the loader has finished with it.
+static Skill::Predictor predictor;
+
+// Poses edited joint by joint. A loaded skill may point at cached data, which must not change under the cache.
+static char editedPose[DOF];
+
+// Skills served straight from flash, ahead of the I2C EEPROM. Only zero is built in, since its data is fixed.
+// The instinct image is written to the I2C EEPROM separately and is not part of this tree, so other skills
+// can only be added here by copying them from the image installed on the robot.
+static const char zeroSkill[] PROGMEM = {
+    1, 0, 0, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+static const Skill::ProgmemSkill FLASH_SKILLS[] PROGMEM = {
+    {Skill::slot(Command::Simple::Zero), zeroSkill},
+};
+
+#ifdef ATTITUDE_DMP
+static Attitude::Dmp dmpAttitude{true};
+static Attitude::Provider& attitude = dmpAttitude;
+#else
+static Attitude::Attitude filterAttitude{};
+static Attitude::Provider& attitude = filterAttitude;
+static Attitude::ImuFifo imuFifo{};
+static Attitude::DataReady imuDataReady{};
+#endif
+
+static Servo::Trajectory trajectory{};
+static bool shutAfterTrajectory = false;
+static Skill::Behaviour behaviour{};
+static Command::Queue commandQueue{};
+static Skill::Sequencer sequencer{};
+static Skill::Crossfade crossfade{};
+
+// The trajectory is stepped by the motion task, so posture changes don't hold up attitude and input.
+template <typename T>
+static void startTrajectory(const T* target, uint8_t angleDataRatio = 1, float speedRatio = 1, uint8_t offset = 0, bool shutServoAfterward = false) {
+    trajectory.begin(currentAng, target, angleDataRatio, speedRatio, offset);
+    shutAfterTrajectory = shutServoAfterward;
+}
+
+static void stepTrajectory() {
+    Servo::Angle angles[DOF];
+    if (trajectory.step(angles, micros())) {
+        for (uint8_t i = trajectory.offset(); i < DOF; i++) {
+            calibratedPWM(i, angles[i]);
+        }
+        servoFrame.commit();
+    }
+    if (!trajectory.active() && shutAfterTrajectory) {
+        shutAfterTrajectory = false;
+        shutServos();
+    }
+}
 
-static Attitude::Attitude attitude{};
+// Only for callers which have to reach the pose before carrying on.
+static void runTrajectory() {
+    do {
+        stepTrajectory();
+    } while (trajectory.active());
+}
+
+// Gait to gait changes keep walking through the load and fade into the new gait, rather than posing and restarting it.
+// Must be called before the load, which may reuse the old gait's frames.
+static void beginCrossfade(const Command::Command& cmd, bool gaitPlaying, uint8_t frameIndex) {
+    if (gaitPlaying && (cmd.type() == Command::Type::Move) && (skill.type == Skill::Type::Gait)) {
+        crossfade.begin(skill, frameIndex);
+    } else {
+        crossfade.stop();
+    }
+}
+
+static void holdCrossfade(uint8_t firstMotionJoint) {
+    Servo::Angle angles[WALKING_DOF];
+    crossfade.hold(angles);
+    for (uint8_t i = 0; i < WALKING_DOF; i++) {
+        calibratedPWM(firstMotionJoint + i, angles[i]);
+    }
+    servoFrame.commit();
+}
 
 
 static void doPostureCommand(Command::Command& cmd, byte angleDataRatio = 1, float speedRatio = 1, bool shutServoAfterward = true) {
+    behaviour.abort(); // The skill it is playing is about to be replaced.
+    crossfade.stop();
+    predictor.observe(Skill::slot(cmd));
     loader->load(cmd, skill);
+    skillLoading = false;
     if (skill.type != Skill::Type::Posture) {
         return;
     }
-    transform(skill.spec, angleDataRatio, speedRatio);
+    char pose[DOF];
+    skill.copyFrame(0, pose);
+    startTrajectory(pose, angleDataRatio, speedRatio, 0, shutServoAfterward);
     if (shutServoAfterward) {
-        shutServos();
         cmd = Command::Command(Command::Simple::Rest);
     }
 }
 
+#ifdef ATTITUDE_DMP
 static void updateAttitude() {
-    Attitude::Measurement m;
-    m.us = micros();
-    mpu.getMotion6(&m.accel.x, &m.accel.y, &m.accel.z, &m.gyro.x, &m.gyro.y, &m.gyro.z);
-    m.accel.x = -m.accel.x;
-    m.accel.y = -m.accel.y;
-    m.gyro.x = -m.gyro.x;
-    m.gyro.y = -m.gyro.y;
-    attitude.update(m);
+    Attitude::Quaternion q;
+    if (DmpReader::read(q)) {
+        dmpAttitude.update(q);
+    }
+}
+#else
+// A sample landing between the FIFO reset and the clear would be left without its stamp, and every later sample
+// would take the stamp of the one after it. Resetting just after a data ready edge leaves a whole sample period
+// for both. Without the interrupt wired up the wait times out, and the FIFO is reset anyway.
+static void resetImuFifo() {
+    imuDataReady.waitForNext(2 * IMU_SAMPLE_PERIOD_US);
+    mpu.resetFIFO();
+    imuDataReady.clear();
+    imuFifo.restart();
+}
+
+// Drains what the MPU6050 has sampled since the last tick, so no samples are lost and each is integrated at the sample rate.
+static void updateAttitude() {
+    const uint16_t overflows = imuFifo.overflows();
+    const uint8_t samples = imuFifo.pending(mpu.getFIFOCount());
+    if (imuFifo.overflows() != overflows) {
+        resetImuFifo();
+        return;
+    }
+    if (samples == 0) {
+        return;
+    }
+    uint8_t bytes[IMU_FIFO_BATCH * IMU_FIFO_SAMPLE_BYTES];
+    mpu.getFIFOBytes(bytes, samples * IMU_FIFO_SAMPLE_BYTES);
+
+    Attitude::Measurement m[IMU_FIFO_BATCH];
+    imuFifo.decode(bytes, samples, micros(), m, &imuDataReady);
+    for (uint8_t i = 0; i < samples; i++) {
+        m[i].accel.x = -m[i].accel.x;
+        m[i].accel.y = -m[i].accel.y;
+        m[i].gyro.x = -m[i].gyro.x;
+        m[i].gyro.y = -m[i].gyro.y;
+    }
+    filterAttitude.updateBatch(m, samples);
 }
+#endif
 
 #define LARGE_PITCH_RAD (LARGE_PITCH * M_DEG2RAD)
 #define LARGE_ROLL_RAD (LARGE_ROLL * M_DEG2RAD)
@@ -161,55 +302,59 @@ static void checkBodyMotion(Command::Command& newCmd)  {
     }
 }
 
-static void doBehaviorSkill(Skill::Skill& skill) {
-    int8_t repeat = skill.loopSpec.count - 1;
-    int8_t frameSize = 20;
-    const int8_t angleMultiplier = (skill.doubleAngles) ? 2 : 1;
-    for (uint8_t c = 0; c < skill.frames; c++) { //the last two in the row are transition speed and delay
-        transform(skill.spec + c * frameSize, angleMultiplier, skill.spec[16 + c * frameSize] / 4.0);
-
-        if (skill.spec[18 + c * frameSize]) {
-            int triggerAxis = skill.spec[18 + c * frameSize];
-            float triggerAngle = (float)skill.spec[19 + c * frameSize] * M_DEG2RAD;
-
-            float currentAngle = attitude.angleFromAxis(triggerAxis);
-            float previousAngle = currentAngle;
-            while (1) {
-                updateAttitude();
-                currentAngle = attitude.angleFromAxis(triggerAxis);
-                PT(currentAngle);
-                PTF("\t");
-                PTL(triggerAngle);
-                if ((M_PI - fabs(currentAngle) > 2.0)  //skip the angle when the reading jumps from 180 to -180
-                    && (triggerAxis * currentAngle < triggerAxis * triggerAngle && triggerAxis * previousAngle > triggerAxis * triggerAngle )) {
-                    //the sign of triggerAxis will deterine whether the current angle should be larger or smaller than the trigger angle
-                    break;
-                }
-                previousAngle = currentAngle;
-            }
-        } else {
-            delay(skill.spec[17 + c * frameSize] * 50);
+// Returns true on the tick the behaviour finishes.
+static bool doBehaviourStep() {
+    if (trajectory.active()) {
+        stepTrajectory();
+    }
+    const float axisAngle = attitude.angleFromAxis(behaviour.triggerAxis());
+    switch (behaviour.step(micros(), trajectory.active(), axisAngle)) {
+        case Skill::Behaviour::Action::Move: {
+            startTrajectory(behaviour.frame(), behaviour.angleMultiplier(), behaviour.speedRatio());
+            stepTrajectory();
+            return false;
+        }
+        case Skill::Behaviour::Action::Done: {
+            return true;
         }
-        if (c == skill.loopSpec.finalRow && repeat > 0) {
-            c = skill.loopSpec.firstRow - 1;
-            repeat--;
+        default: {
+            return false;
         }
     }
 }
 
-#define NUM_TASKS (3)
+static void finishBehaviour() {
+    lastCmd = Command::Command(Command::Simple::Balance);
+    doPostureCommand(lastCmd, 1, 2, false);
+    for (byte a = 0; a < DOF; a++) {
+        currentAdjust[a] = 0.0f;
+    }
+}
+
+#define NUM_TASKS (5)
 #define INPUT_PERIOD_US (15000)
 #define ATTITUDE_PERIOD_US (5000)
 #define MOTION_PERIOD_US (20000)
+#define DISPATCH_PERIOD_US (10000)
+#define SEQUENCE_TICKS_PER_TENTH (100000 / MOTION_PERIOD_US)
+#define LOADER_PERIOD_US (5000)
 static Scheduler::Scheduler<NUM_TASKS> scheduler{};
 #define TASK_ATTITUDE (0)
 #define TASK_INPUT (1)
 #define TASK_MOTION (2)
+#define TASK_LOADER (3)
+#define TASK_DISPATCH (4)
+#define PREFETCH_MIN_SLACK_US (2000) // One loader step is ~1ms of I2C at 400kHz
+
+static void doIdleTask(uint32_t slackUs);
 
 static void initScheduler(){
     scheduler.registerTask(ATTITUDE_PERIOD_US);
     scheduler.registerTask(INPUT_PERIOD_US);
     scheduler.registerTask(MOTION_PERIOD_US);
+    scheduler.registerTask(LOADER_PERIOD_US);
+    scheduler.registerTask(DISPATCH_PERIOD_US);
+    scheduler.setIdleTask(doIdleTask);
 }
 
 static void initI2C() {
@@ -222,6 +367,11 @@ static void initIMU() {
     PTL(mpu.testConnection() ? F("MPU6050 connection successful") : F("MPU6050 connection failed"));
 
     delay(500);
+#ifdef ATTITUDE_DMP
+    if (!DmpReader::begin()) {
+        PTLF("DMP failed to start");
+    }
+#endif
     // supply your own gyro offsets here, scaled for min sensitivity
     for (byte i = 0; i < 4; i++) {
         PT(EEPROMReadInt(MPUCALIB + 4 + i * 2));
@@ -232,21 +382,69 @@ static void initIMU() {
     mpu.setYGyroOffset(EEPROMReadInt(MPUCALIB + 8));
     mpu.setZGyroOffset(EEPROMReadInt(MPUCALIB + 10));
 
+#ifndef ATTITUDE_DMP // The DMP picks its own rate and ranges, and owns the FIFO
     mpu.setDLPFMode(2); // Effectively 100Hz bandwidth for gyro and accel
     mpu.setFullScaleAccelRange(MPU6050_ACCEL_FS_2); // Don't need anything beyond 2g
     mpu.setFullScaleGyroRange(MPU6050_GYRO_FS_1000);
+
+    // Accel and gyro into the FIFO at a fixed rate, drained by updateAttitude()
+    mpu.setRate(IMU_SAMPLE_RATE_DIVIDER);
+    mpu.setTempFIFOEnabled(false);
+    mpu.setAccelFIFOEnabled(true);
+    mpu.setXGyroFIFOEnabled(true);
+    mpu.setYGyroFIFOEnabled(true);
+    mpu.setZGyroFIFOEnabled(true);
+    mpu.setFIFOEnabled(true);
+
+    // Data ready pulses on INT, so each sample is stamped when it was taken rather than when it is read
+    mpu.setInterruptMode(false); // Active high
+    mpu.setInterruptLatch(false); // 50us pulse
+    mpu.setIntDataReadyEnabled(true);
+    imuDataReady.attach(INTERRUPT);
+    resetImuFifo();
+#endif
 }
 
 static void processNewCommand(Command::Command& newCmd, Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
-static void doMotionTask(bool enableMotion, const Skill::Skill& skill, uint8_t firstMotionJoint, uint8_t& frameIndex);
+static void doMotionTask(Command::Move& move, bool& enableMotion, const Skill::Skill& skill, uint8_t& firstMotionJoint, uint8_t& frameIndex);
+static void startSequenceStep(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
 static void doMotionPosture(const Skill::Skill& skill);
 static void doMotionMove(const Skill::Skill& skill, uint8_t firstMotionJoint, uint8_t& frameIndex);
 static void doInputTask(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
 static void doAttitudeTask(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
+static void doLoaderTask(const Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
+static void doDispatchTask(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
+
+// Points the skill at editedPose, starting from the current posture or, for any other skill, where the joints are.
+static void usePoseCopy() {
+    if (skill.spec == editedPose) {
+        return;
+    }
+    if (skill.type == Skill::Type::Posture) {
+        skill.copyFrame(0, editedPose);
+    } else {
+        for (uint8_t i = 0; i < DOF; i++) {
+            editedPose[i] = (char)currentAng[i];
+        }
+        skill.doubleAngles = false;
+    }
+    skill.type = Skill::Type::Posture;
+    skill.frames = 1;
+    skill.spec = editedPose;
+    skill.specLength = DOF;
+    skill.stream = NULL;
+    skill.progmem = false;
+}
+static void startSkill(const Command::Command& newCmd, const Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex);
 
 void Bittleet::setup() {
     skill = Skill::Skill::Empty();
-    loader = new Skill::LoaderEeprom();
+    eepromLoader = new Skill::LoaderEeprom();
+    eepromLoader->streamGaits(&gaitStream);
+    progmemLoader = new Skill::LoaderProgmem(FLASH_SKILLS, sizeof(FLASH_SKILLS) / sizeof(FLASH_SKILLS[0]));
+    compositeLoader = new Skill::LoaderComposite(*progmemLoader, *eepromLoader);
+    cachedLoader = new Skill::LoaderCached(*compositeLoader);
+    loader = cachedLoader;
     pinMode(BUZZER, OUTPUT);
 
     initScheduler();
@@ -260,6 +458,7 @@ void Bittleet::setup() {
     PTLF("Bittle");
     PTLF("Initialize I2C");
     initI2C();
+    eepromLoader->checkImage();
     initIMU();
 
     irrecv.enableIRIn(); // Start the receiver
@@ -273,17 +472,16 @@ void Bittleet::setup() {
 
         pwm.setPWMFreq(60 * PWM_FACTOR); // Analog servos run at ~60 Hz updates
         delay(200);
+        servoFrame.begin();
 
         //meow();
+        servoCalibration.load();
         for (int8_t i = DOF - 1; i >= 0; i--) {
-            // TODO: Investigate loading middleShift, pulsePerDeg and rotationDirection into RAM/ROM
-            servoRange[i] = servoAngleRange(i);
-            servoCalibs[i] = servoCalib(i);
-            calibratedDuty0[i] =  SERVOMIN + PWM_RANGE / 2 + float(middleShift(i) + servoCalibs[i]) * pulsePerDegreeF(i)  * rotationDirection(i) ;
+            servoCalibs[i] = servoCalibration.joint(i).calib;
         }
         lastCmd = Command::Command(Command::Simple::Rest);
         doPostureCommand(lastCmd);
-        shutServos();
+        runTrajectory();
     }
     beep(30);
 
@@ -315,10 +513,33 @@ void Bittleet::loop() {
     int currentTask = scheduler.waitUntilNextTask();
     lastUs = micros();
 
-    PTF("task: "); PT(currentTask);
-    PTF("\tdeltaT: "); PT(deltaUs); 
-    PTF("\tfree memory: "); PT(freeMemory());
-    PTL();
+    static int lowestFreeMemory = freeMemory();
+    const int currentFreeMemory = freeMemory();
+    if (currentFreeMemory < lowestFreeMemory) {
+        lowestFreeMemory = currentFreeMemory;
+    }
+
+    // The whole line blocks for about 17ms at 115200 baud, so it can't go out on every 5ms task.
+    static uint32_t statsUs = lastUs;
+    static uint32_t maxDeltaUs = 0;
+    maxDeltaUs = (deltaUs > maxDeltaUs) ? deltaUs : maxDeltaUs;
+    if (lastUs - statsUs >= STATS_PERIOD_US) {
+        statsUs = lastUs;
+        PTF("max deltaT: "); PT(maxDeltaUs);
+        PTF("\tfree memory: "); PT(currentFreeMemory);
+        PTF("\tlowest: "); PT(lowestFreeMemory);
+        PTF("\tskill arena: "); PT(eepromLoader->arenaHighWatermark());
+        PTF("\tcache hit/miss: "); PT(cachedLoader->hits()); PTF("/"); PT(cachedLoader->misses());
+        PTF("\tprefetched: "); PT(cachedLoader->prefetches());
+        PTF("\tservo bus us: "); PT(servoFrame.lastCommitUs()); PTF("/"); PT(servoFrame.maxCommitUs());
+        PTF("\tcommands: "); PT(commandQueue.depth()); PTF("/"); PT(commandQueue.maxDepth());
+        PTF(" dropped: "); PT(commandQueue.drops());
+#ifndef ATTITUDE_DMP
+        PTF("\timu overflows: "); PT(imuFifo.overflows()); PTF("/"); PT(imuDataReady.overflows());
+#endif
+        PTL();
+        maxDeltaUs = 0;
+    }
 
 
     int battAdcReading = analogRead(BATT);
@@ -334,13 +555,21 @@ void Bittleet::loop() {
                 break;
             }
             case TASK_MOTION: {
-                doMotionTask(enableMotion, skill, firstMotionJoint, frameIndex);
+                doMotionTask(move, enableMotion, skill, firstMotionJoint, frameIndex);
                 break;
             }
             case TASK_INPUT: {
                 doInputTask(move, enableMotion, firstMotionJoint, frameIndex);
                 break;
             }
+            case TASK_LOADER: {
+                doLoaderTask(move, enableMotion, firstMotionJoint, frameIndex);
+                break;
+            }
+            case TASK_DISPATCH: {
+                doDispatchTask(move, enableMotion, firstMotionJoint, frameIndex);
+                break;
+            }
         }
     }
 }
@@ -352,17 +581,10 @@ static void doInputTask(Command::Move& move, bool& enableMotion, uint8_t& firstM
     if (irrecv.decode(&results)) {
         Command::Command newCmd = Infrared::parseSignal((results.value >> 8), move);
         irrecv.resume(); // receive the next value
-        if (newCmd.type() != Command::Type::None) {
-            processNewCommand(newCmd, move, enableMotion, firstMotionJoint, frameIndex);
-        }
+        commandQueue.push(newCmd);
     }
     
-    {
-        Command::Command newCmd = serialComms.parse(move, currentAng);
-        if (newCmd.type() != Command::Type::None) {
-            processNewCommand(newCmd, move, enableMotion, firstMotionJoint, frameIndex);
-        }
-    }
+    commandQueue.push(serialComms.parse(move, currentAng));
 
     
 }
@@ -370,15 +592,27 @@ static void doInputTask(Command::Move& move, bool& enableMotion, uint8_t& firstM
 static void doAttitudeTask(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
     Command::Command newCmd = Command::Command();
 
-    if (checkGyro) {
+    if (behaviour.active()) {
+        updateAttitude(); // Triggers need the attitude, but balance recovery would fight the behaviour.
+    } else if (checkGyro) {
         checkBodyMotion(newCmd);
     }
 
-    processNewCommand(newCmd, move, enableMotion, firstMotionJoint, frameIndex);
+    commandQueue.push(newCmd);
+}
+
+// One command per tick, so a command which starts a load has the loader task to itself before the next.
+static void doDispatchTask(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
+    Command::Command newCmd;
+    if (commandQueue.pop(newCmd)) {
+        sequencer.stop(); // Anything else asked for takes over from a sequence.
+        processNewCommand(newCmd, move, enableMotion, firstMotionJoint, frameIndex);
+    }
 }
 
 
 static void processNewCommand(Command::Command& newCmd, Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex){
+    const bool gaitPlaying = enableMotion && !skillLoading && !trajectory.active() && (skill.type == Skill::Type::Gait);
     if (newCmd.type() == Command::Type::Move) {
         if (newCmd.get(move) == false) {
             PTLF("Move Err"); // Unexpected...
@@ -408,6 +642,10 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                     if (enableMotion) {
                         newCmd = Command::Command(); // resume last command. TODO - don't know if this works?
                     } else {
+                        behaviour.abort();
+                        crossfade.stop();
+                        trajectory.stop();
+                        shutAfterTrajectory = false;
                         shutServos();
                     }
                     break;
@@ -419,8 +657,9 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                 }
                 case Command::Simple::AbortServoCalibration: {
                     PTLF("aborted");
+                    servoCalibration.load();
                     for (byte i = 0; i < DOF; i++) {
-                        servoCalibs[i] = servoCalib( i);
+                        servoCalibs[i] = servoCalibration.joint(i).calib;
                     }
                     break;
                 }
@@ -444,9 +683,13 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                     printList(servoCalibs);
                     if (lastCmd != newCmd) { //first time entering the calibration function
                         lastCmd = newCmd;
+                        behaviour.abort();
+                        crossfade.stop();
                         loader->load(newCmd, skill);
                         if (skill.type != Skill::Type::Invalid) {
-                            transform(skill.spec);
+                            char pose[DOF];
+                            skill.copyFrame(0, pose);
+                            startTrajectory(pose);
                         }
                         checkGyro = false;
                     }
@@ -461,8 +704,9 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                             angle = servoCalibs[index] + angle + 1000;
                         }
                         servoCalibs[index] = angle;
-                        int duty = SERVOMIN + PWM_RANGE / 2 + float(middleShift(index)  + servoCalibs[index] + skill.spec[index]) * pulsePerDegreeF(index) * rotationDirection(index);
-                        pwm.setPWM(pin(index), 0,  duty);
+                        servoCalibration.setCalib(index, angle);
+                        servoFrame.set(servoCalibration.joint(index).pin, servoCalibration.duty(index, skill.angle(0, index)));
+                        servoFrame.commit();
                     }
                     break;
                 }
@@ -470,7 +714,9 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                     const float angleInterval = 0.2;
                     int angleStep = 0;
                     const int16_t joints = cmd.len/2;
-                    skill.type = Skill::Type::Posture;
+                    usePoseCopy();
+                    behaviour.abort();
+                    trajectory.stop();
                     for (int16_t i = 0; i < joints; i++) {
                         int16_t index = cmd.args[0];
                         int16_t angle = cmd.args[1];
@@ -479,10 +725,11 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                         //      - we can probably simplify this a lot.
                         angleStep = floor((angle - currentAng[index]) / angleInterval);
                         for (int a = 0; a < abs(angleStep); a++) {
-                            int duty = SERVOMIN + PWM_RANGE / 2 + float(middleShift(index)  + servoCalibs[index] + currentAng[index] + a * angleInterval * angleStep / abs(angleStep)) * pulsePerDegreeF(index) * rotationDirection(index);
-                            pwm.setPWM(pin(index), 0,  duty);
+                            const float stepAngle = currentAng[index] + a * angleInterval * angleStep / abs(angleStep);
+                            servoFrame.set(servoCalibration.joint(index).pin, servoCalibration.duty(index, stepAngle));
+                            servoFrame.commit();
                         }
-                        skill.spec[index] = angle;
+                        editedPose[index] = angle;
                         currentAng[index] = angle;
                     }
                     break;
@@ -499,11 +746,30 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
                     beep(note, duration);
                     break;
                 }
+                case Command::ArgType::Sequence: {
+                    sequencer.clear();
+                    bool added = true;
+                    for (uint8_t a = 0; added && (a + 1 < cmd.len); a += 2) {
+                        const int8_t amount = cmd.args[a + 1];
+                        const uint16_t ticks = (amount < 0) ? -amount * SEQUENCE_TICKS_PER_TENTH : 0;
+                        added = sequencer.add((Skill::Slot)cmd.args[a], ticks, (amount > 0) ? amount : 0);
+                    }
+                    if (!added) {
+                        PTLF("Sequence Err"); // Slot with no skill, play nothing rather than part of it
+                        sequencer.clear();
+                    } else if (sequencer.start()) {
+                        startSequenceStep(move, enableMotion, firstMotionJoint, frameIndex);
+                    }
+                    newCmd = lastCmd; // Already loading the first step
+                    break;
+                }
                 case Command::ArgType::MoveSimultaneously: {
                     if (cmd.len != DOF) {
                         PTLF("Simultaneous Err"); // Unexpected...
                     } else {
-                        transform(cmd.args, 1, 6);
+                        behaviour.abort();
+                        crossfade.stop();
+                        startTrajectory(cmd.args, 1, 6);
                     }
                     break;
                 }
@@ -517,51 +783,149 @@ static void processNewCommand(Command::Command& newCmd, Command::Move& move, boo
 
     if ((newCmd != Command::Command()) && (newCmd != lastCmd)) {
         PTL("Loading...");
-        loader->load(newCmd, skill);
+        predictor.observe(Skill::slot(newCmd));
+        behaviour.abort();
+        beginCrossfade(newCmd, gaitPlaying, frameIndex);
+        loader->begin(newCmd, skill);
+        skillLoading = true;
+        lastCmd = newCmd;
+    }
+}
+
+static void doLoaderTask(const Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
+    if (skillLoading && loader->step()) {
+        skillLoading = false;
         PTL("Loaded");
+        const Command::Command loadedCmd = lastCmd; // startSkill may replace lastCmd
+        startSkill(loadedCmd, move, enableMotion, firstMotionJoint, frameIndex);
+    }
+}
 
-        offsetLR = 0;
-        if (newCmd.type() == Command::Type::Move) {
-            if (newCmd.get(move)) {
-                if (move.direction == Command::Direction::Left) {
-                    offsetLR = 15;
-                } else if (move.direction == Command::Direction::Right) {
-                    offsetLR = -15;
-                }
-            }
-        } 
+// Loads the skill we expect to be asked for next into the cache while there is nothing else to do.
+static void doIdleTask(uint32_t slackUs) {
+    if (skillLoading || (slackUs < PREFETCH_MIN_SLACK_US)) {
+        return;
+    }
+    if (cachedLoader->prefetching()) {
+        cachedLoader->step();
+        return;
+    }
+    // Gaits are streamed through the same GaitStream as the gait being played, so they are never prefetched.
+    const Skill::Slot next = sequencer.active() ? Skill::slot(sequencer.next()) : predictor.predict();
+    if ((next != SKILL_SLOT_NONE) && (next >= SKILL_MOVE_SLOTS)) {
+        cachedLoader->prefetch(Skill::slotCommand(next));
+    }
+}
 
-        frameIndex = 0;
+static void startSkill(const Command::Command& newCmd, const Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
+    offsetLR = 0;
+    if (newCmd.type() == Command::Type::Move) {
+        if (move.direction == Command::Direction::Left) {
+            offsetLR = 15;
+        } else if (move.direction == Command::Direction::Right) {
+            offsetLR = -15;
+        }
+    } 
 
-        lastCmd = newCmd;
+    frameIndex = 0;
+    const bool blending = crossfade.active() && (skill.type == Skill::Type::Gait);
+    if (!blending) {
+        crossfade.stop();
+    }
 
-        postureOrWalkingFactor = (skill.type == Skill::Type::Posture) ? 1 : POSTURE_WALKING_FACTOR;
-        firstMotionJoint = (skill.type == Skill::Type::Gait) ? DOF - WALKING_DOF : 0;
+    postureOrWalkingFactor = (skill.type == Skill::Type::Posture) ? 1 : POSTURE_WALKING_FACTOR;
+    firstMotionJoint = (skill.type == Skill::Type::Gait) ? DOF - WALKING_DOF : 0;
+
+    if (skill.type == Skill::Type::Behaviour) {
+        behaviour.begin(skill); // Played by the motion task
+    } else if (blending) {
+        frameIndex = crossfade.alignedFrame(skill.frames); // Faded in by doMotionMove
+    } else if (skill.type != Skill::Type::Invalid) {
+        int8_t angleMultiplier = (skill.doubleAngles) ? 2 : 1;
+        char frame[DOF];
+        skill.copyFrame(0, frame);
+        startTrajectory(frame, angleMultiplier, 1, firstMotionJoint, newCmd == Command::Simple::Rest);
+    }
 
-        if (skill.type == Skill::Type::Behaviour) {
-            doBehaviorSkill(skill);
-            lastCmd = Command::Command(Command::Simple::Balance);
-            doPostureCommand(lastCmd, 1, 2, false);
-            for (byte a = 0; a < DOF; a++) {
-                currentAdjust[a] = 0.0f;
-            }
-        } else if (skill.type != Skill::Type::Invalid) {
-            int8_t angleMultiplier = (skill.doubleAngles) ? 2 : 1;
-            transform(skill.spec, angleMultiplier, 1, firstMotionJoint);
+    if (newCmd == Command::Simple::Rest) {
+        if (!trajectory.active()) {
+            shutServos();
         }
+        enableMotion = false;
+    }
+}
 
-        if (newCmd == Command::Simple::Rest) {
-            shutServos();
-            enableMotion = false;
+static void doSequenceTick(bool cycleComplete, Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
+    switch (sequencer.tick(cycleComplete)) {
+        case Skill::Sequencer::Action::Start: {
+            startSequenceStep(move, enableMotion, firstMotionJoint, frameIndex);
+            break;
         }
+        case Skill::Sequencer::Action::Done: {
+            if ((skill.type == Skill::Type::Behaviour) && !behaviour.active()) {
+                finishBehaviour();
+            }
+            break;
+        }
+        default: {
+            if (cycleComplete && (skill.type == Skill::Type::Behaviour)) {
+                behaviour.begin(skill); // Play it again
+            }
+            break;
+        }
+    }
+}
+
+// The next skill is usually already in the cache from doIdleTask, so it starts on the tick the last one finished.
+static void startSequenceStep(Command::Move& move, bool& enableMotion, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
+    const Command::Command cmd = sequencer.current();
+    const bool gaitPlaying = enableMotion && !skillLoading && !trajectory.active() && (skill.type == Skill::Type::Gait);
+    enableMotion = cmd.get(move);
+    predictor.observe(Skill::slot(cmd));
+    behaviour.abort();
+    beginCrossfade(cmd, gaitPlaying, frameIndex);
+    loader->begin(cmd, skill);
+    skillLoading = true;
+    lastCmd = cmd;
+    if (loader->step()) {
+        skillLoading = false;
+        startSkill(cmd, move, enableMotion, firstMotionJoint, frameIndex);
     }
 }
 
-static void doMotionTask(bool enableMotion, const Skill::Skill& skill, uint8_t firstMotionJoint, uint8_t& frameIndex) {
-    if (enableMotion) {
+static void doMotionTask(Command::Move& move, bool& enableMotion, const Skill::Skill& skill, uint8_t& firstMotionJoint, uint8_t& frameIndex) {
+    const bool sequencing = sequencer.active();
+    bool cycleComplete = false;
+    if (behaviour.active()) {
+        if (doBehaviourStep()) {
+            cycleComplete = true;
+            if (!sequencing) {
+                finishBehaviour();
+            }
+        }
+    } else if (trajectory.active()) {
+        stepTrajectory(); // The skill takes over once its first pose is reached.
+        cycleComplete = !trajectory.active() && (skill.type == Skill::Type::Posture);
+    } else if (skillLoading) {
+        if (crossfade.active()) {
+            holdCrossfade(firstMotionJoint); // Keep walking on the old gait
+        }
+        return; // Otherwise hold the current pose until the new skill has loaded.
+    } else if (enableMotion) {
         doMotionMove(skill, firstMotionJoint, frameIndex);
+        servoFrame.commit();
+        if (skill.stream != NULL) {
+            skill.stream->prefetch(); // Next frame is ready before the next motion tick.
+        }
+        cycleComplete = (skill.type == Skill::Type::Gait) && (frameIndex >= skill.frames);
     } else {
         doMotionPosture(skill);
+        servoFrame.commit();
+        cycleComplete = (skill.type == Skill::Type::Posture);
+    }
+
+    if (sequencing) {
+        doSequenceTick(cycleComplete, move, enableMotion, firstMotionJoint, frameIndex);
     }
 }
 
@@ -577,7 +941,7 @@ static void doMotionPosture(const Skill::Skill& skill) {
             } else {
                 int8_t angleMultiplier = (skill.doubleAngles) ? 2 : 1;
                 float attitudeAdjustment = (checkGyro ? adjust(i) : 0.0f);
-                calibratedPWM(i, skill.spec[i]*angleMultiplier + attitudeAdjustment);
+                calibratedPWM(i, skill.angle(0, i)*angleMultiplier + attitudeAdjustment);
             }
         }
     }
@@ -588,6 +952,8 @@ static void doMotionMove(const Skill::Skill& skill, uint8_t firstMotionJoint, ui
         if (frameIndex >= skill.frames) {
             frameIndex = 0;
         }
+        Servo::Angle blended[WALKING_DOF];
+        const bool blending = crossfade.step(skill, frameIndex, blended);
 
         for (int i = 0; i<DOF; i++) {
             if (i == 0) {
@@ -602,8 +968,7 @@ static void doMotionMove(const Skill::Skill& skill, uint8_t firstMotionJoint, ui
                 }
                 
                 int8_t angleMultiplier = (skill.doubleAngles) ? 2 : 1;
-                int dutyIdx = frameIndex * WALKING_DOF + (i - firstMotionJoint);
-                calibratedPWM(i, skill.spec[dutyIdx]*angleMultiplier);
+                calibratedPWM(i, blending ? blended[i - firstMotionJoint] : Servo::Angle::fromInt(skill.angle(frameIndex, i - firstMotionJoint)*angleMultiplier));
             }
         }
         frameIndex++;
@@ -0,0 +1,48 @@
+//
+// DMP Reader
+// Starts the MPU6050's DMP and reads its quaternion packets
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "../3rdParty/MPU6050/MPU6050_6Axis_MotionApps20.h" // Must come before MPU6050.h
+#include "DmpReader.h"
+
+#define DMP_MAX_PACKET_BYTES (42)
+
+namespace DmpReader {
+
+static MPU6050 imu;
+static uint16_t packetSize = 0;
+
+MPU6050& mpu() {
+    return imu;
+}
+
+bool begin() {
+    if (imu.dmpInitialize() != 0) {
+        return false;
+    }
+    packetSize = imu.dmpGetFIFOPacketSize();
+    if (packetSize > DMP_MAX_PACKET_BYTES) {
+        return false;
+    }
+    imu.setDMPEnabled(true);
+    return true;
+}
+
+bool read(Attitude::Quaternion& q) {
+    uint8_t packet[DMP_MAX_PACKET_BYTES];
+    if ((packetSize == 0) || (imu.getFIFOCount() < packetSize)) {
+        return false;
+    }
+    if (imu.GetCurrentFIFOPacket(packet, packetSize) == 0) {
+        return false;
+    }
+    q = Attitude::Quaternion::fromPacket(packet);
+    return true;
+}
+
+} // namespace DmpReader
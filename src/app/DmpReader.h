@@ -0,0 +1,32 @@
+//
+// DMP Reader
+// Starts the MPU6050's DMP and reads its quaternion packets
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_APP_DMP_READER_H_ 
+#define _BITTLEET_APP_DMP_READER_H_
+
+#include "../3rdParty/MPU6050/MPU6050.h"
+#include "../state/Dmp.h"
+
+// MotionApps defines its functions in its header, so it may only be included by one file; this is that file.
+// It also adds DMP members to MPU6050, so the MPU6050 is defined there too, where it gets room for them.
+// Other files only reach it through mpu() and must not define their own.
+namespace DmpReader {
+
+// The one MPU6050, for the DMP and raw register reads alike.
+MPU6050& mpu();
+
+// Loads the DMP firmware and starts it. Overwrites the sample rate, DLPF and gyro range, so set offsets afterwards.
+bool begin();
+
+// The newest quaternion, skipping any older packets still queued. Returns false if no packet was ready.
+bool read(Attitude::Quaternion& q);
+
+}
+
+#endif // _BITTLEET_APP_DMP_READER_H_
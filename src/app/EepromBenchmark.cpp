@@ -0,0 +1,113 @@
+//
+// EEPROM Benchmark App
+// Measures how fast each type of skill loads from the I2C EEPROM.
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "EepromBenchmark.h"
+#include "../skill/LoaderEeprom.h"
+#include "../skill/I2cEeprom.h"
+
+#include <Arduino.h>
+#include <Wire.h>
+
+#define LEGACY_WIRE_BUFFER (8) // The request size LoaderEeprom used before I2cEeprom
+#define NUM_TYPES (4)
+
+// Gaits are not streamed, so every skill is loaded in full.
+class BenchmarkLoader : public Skill::LoaderEeprom {
+public:
+    int16_t address(Skill::Slot s) const { return _addresses[s]; }
+};
+
+struct Result {
+    uint32_t bytes;
+    uint32_t us;
+    uint32_t legacyUs;
+    uint8_t skills;
+};
+
+static BenchmarkLoader* loader;
+static char buffer[SKILL_ARENA_SIZE + 7];
+
+static void initI2C() {
+  Wire.begin();
+  Wire.setClock(400000);
+}
+
+// One address write per load and small requests, as skills were loaded before.
+static void legacyRead(uint16_t address, char* dest, uint16_t len) {
+  Wire.beginTransmission(I2C_EEPROM_ADDRESS);
+  Wire.write((int)((address) >> 8));   // MSB
+  Wire.write((int)((address) & 0xFF)); // LSB
+  Wire.endTransmission();
+  uint16_t index = 0;
+  while (len > 0) {
+    Wire.requestFrom(I2C_EEPROM_ADDRESS, (int)((len < LEGACY_WIRE_BUFFER) ? len : LEGACY_WIRE_BUFFER));
+    while (Wire.available() && (len > 0)) {
+      dest[index++] = Wire.read();
+      len--;
+    }
+  }
+  Skill::I2cEeprom::invalidate();
+}
+
+static void printRate(uint32_t bytes, uint32_t us) {
+  Serial.print((us == 0) ? 0.0f : 1000.0f * bytes / us);
+  Serial.print(" B/ms");
+}
+
+void EepromBenchmark::setup() {
+  Serial.begin(115200);
+  while (!Serial);
+
+  initI2C();
+  loader = new BenchmarkLoader();
+}
+
+void EepromBenchmark::loop() {
+  static const char* names[NUM_TYPES] = {"invalid", "posture", "gait", "behaviour"};
+  Result results[NUM_TYPES] = {};
+
+  for (Skill::Slot s = 0; s < SKILL_SLOTS; s++) {
+    const int16_t address = loader->address(s);
+    if (address == -1) {
+      continue;
+    }
+    Skill::Skill skill = Skill::Skill::Empty();
+    uint32_t dt = micros();
+    loader->load(Skill::slotCommand(s), skill);
+    dt = micros() - dt;
+
+    const uint8_t type = (uint8_t)skill.type;
+    const uint16_t header = (skill.type == Skill::Type::Behaviour) ? 7 : 4;
+    const uint16_t bytes = header + skill.specLength;
+
+    uint32_t legacyDt = micros();
+    legacyRead(address, buffer, bytes);
+    legacyDt = micros() - legacyDt;
+
+    results[type].bytes += bytes;
+    results[type].us += dt;
+    results[type].legacyUs += legacyDt;
+    results[type].skills++;
+  }
+
+  for (uint8_t t = 1; t < NUM_TYPES; t++) {
+    Serial.print(names[t]);
+    Serial.print("\tskills: ");
+    Serial.print(results[t].skills);
+    Serial.print("\tbytes: ");
+    Serial.print(results[t].bytes);
+    Serial.print("\tburst: ");
+    printRate(results[t].bytes, results[t].us);
+    Serial.print("\tlegacy: ");
+    printRate(results[t].bytes, results[t].legacyUs);
+    Serial.print("\n");
+  }
+  Serial.print("\n");
+  delay(1000);
+}
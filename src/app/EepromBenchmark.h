@@ -0,0 +1,24 @@
+//
+// EEPROM Benchmark App
+// Measures how fast each type of skill loads from the I2C EEPROM.
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_APP_EEPROM_BENCHMARK_H_ 
+#define _BITTLEET_APP_EEPROM_BENCHMARK_H_
+
+#include "App.h"
+
+class EepromBenchmark : public App {
+public:
+    EepromBenchmark() = default;
+    
+    void setup();
+    void loop();
+};
+
+
+#endif // _BITTLEET_APP_EEPROM_BENCHMARK_H_
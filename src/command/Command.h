@@ -60,6 +60,7 @@ enum class ArgType : uint8_t {
     MoveSimultaneously,
     Meow,
     Beep,
+    Sequence,
     TOTAL
 };
 
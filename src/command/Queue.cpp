@@ -0,0 +1,79 @@
+//
+// Bittleet Command Queue
+// Ring of commands between the input decoders and the dispatcher
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Queue.h"
+
+namespace Command {
+
+bool Queue::isPriority(const Command& cmd) {
+    return (cmd == Simple::Rest) || (cmd == Simple::Pause);
+}
+
+bool Queue::push(const Command& cmd) {
+    if (cmd.type() == Type::None) {
+        return true;
+    }
+    if (isPriority(cmd)) {
+        const uint8_t pushed = _priorityPushed;
+        if ((uint8_t)(pushed - _priorityPopped) >= COMMAND_PRIORITY_SIZE) {
+            _fullDrops++;
+            return false;
+        }
+        Simple simple;
+        cmd.get(simple);
+        _priority[pushed & (COMMAND_PRIORITY_SIZE - 1)] = simple;
+        _priorityHead[pushed & (COMMAND_PRIORITY_SIZE - 1)] = _head;
+        _priorityPushed = pushed + 1; // Publish last
+        return true;
+    }
+
+    const uint8_t head = _head;
+    const uint8_t depth = (uint8_t)(head - _tail);
+    if ((depth != 0) && (_ring[(uint8_t)(head - 1) & (COMMAND_QUEUE_SIZE - 1)] == cmd)) {
+        // If the dispatcher takes it in the meantime, the identical command is still being acted on.
+        _coalesced++;
+        return true;
+    }
+    if (depth >= COMMAND_QUEUE_SIZE) {
+        _fullDrops++;
+        return false;
+    }
+    _ring[head & (COMMAND_QUEUE_SIZE - 1)] = cmd;
+    _head = head + 1; // Publish last
+    if (depth + 1 > _maxDepth) {
+        _maxDepth = depth + 1;
+    }
+    return true;
+}
+
+bool Queue::pop(Command& cmd) {
+    const uint8_t popped = _priorityPopped;
+    if (popped != _priorityPushed) {
+        const uint8_t stale = _priorityHead[popped & (COMMAND_PRIORITY_SIZE - 1)];
+        cmd = Command(_priority[popped & (COMMAND_PRIORITY_SIZE - 1)]);
+        // Anything queued before the priority command is out of date. A pop racing the push may already be past it.
+        const int8_t ahead = (int8_t)(stale - _tail);
+        if (ahead > 0) {
+            _preempted += ahead;
+            _tail = stale;
+        }
+        _priorityPopped = popped + 1;
+        return true;
+    }
+
+    const uint8_t tail = _tail;
+    if (tail == _head) {
+        return false;
+    }
+    cmd = _ring[tail & (COMMAND_QUEUE_SIZE - 1)];
+    _tail = tail + 1;
+    return true;
+}
+
+} // namespace Command
@@ -0,0 +1,65 @@
+//
+// Bittleet Command Queue
+// Ring of commands between the input decoders and the dispatcher
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_COMMAND_QUEUE_H_
+#define _BITTLEET_COMMAND_QUEUE_H_
+
+#include <stdint.h>
+#include "Command.h"
+
+#define COMMAND_QUEUE_SIZE (4) // Must be a power of two
+#define COMMAND_PRIORITY_SIZE (4) // Must be a power of two
+
+namespace Command {
+
+// Single producer, single consumer. Every field is written by only one side and the indices are single bytes,
+// so a decoder can push from an interrupt while the dispatcher pops, without disabling interrupts.
+//
+// A push identical to the newest queued command is coalesced away. Rest and Pause jump the queue:
+// the next pop returns them and throws away whatever was queued ahead of them. They have their own ring and
+// are never coalesced, since Pause is a toggle and two quick Pauses must cancel out rather than become one.
+class Queue {
+  public:
+    Queue() = default;
+
+    // Producer side. Returns false if the command was dropped because the queue was full.
+    bool push(const Command& cmd);
+
+    // Consumer side. Returns false if there was nothing to pop.
+    bool pop(Command& cmd);
+
+    uint8_t depth() const { return (uint8_t)(_head - _tail); }
+    uint8_t maxDepth() const { return _maxDepth; }
+    uint16_t drops() const { return _fullDrops + _preempted; } // Lost to a full queue or pre-empted
+    uint16_t coalesced() const { return _coalesced; }
+
+    static bool isPriority(const Command& cmd);
+
+  protected:
+    Command _ring[COMMAND_QUEUE_SIZE];
+    volatile uint8_t _head = 0; // Free running, written by the producer
+    volatile uint8_t _tail = 0; // Free running, written by the consumer
+
+    // Only Simple commands pre-empt, so each priority command fits in one byte.
+    Simple _priority[COMMAND_PRIORITY_SIZE];
+    uint8_t _priorityHead[COMMAND_PRIORITY_SIZE]; // _head when each priority command was pushed
+    volatile uint8_t _priorityPushed = 0;   // Free running, written by the producer
+    volatile uint8_t _priorityPopped = 0;   // Free running, written by the consumer
+
+    // Producer side
+    uint8_t _maxDepth = 0;
+    uint16_t _fullDrops = 0;
+    uint16_t _coalesced = 0;
+    // Consumer side
+    uint16_t _preempted = 0;
+};
+
+}
+
+#endif // _BITTLEET_COMMAND_QUEUE_H_
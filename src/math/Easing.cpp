@@ -0,0 +1,39 @@
+//
+// Easing
+// Cosine ease for joint interpolation from a PROGMEM table, so stepping a move needs no libm
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Easing.h"
+
+#include <Arduino.h>
+
+#define EASE_ROW(i) \
+    cosineEaseEntry(i),     cosineEaseEntry(i + 1), cosineEaseEntry(i + 2), cosineEaseEntry(i + 3), \
+    cosineEaseEntry(i + 4), cosineEaseEntry(i + 5), cosineEaseEntry(i + 6), cosineEaseEntry(i + 7)
+
+static_assert(EASE_TABLE_SIZE == 64, "COSINE_EASE rows need updating for the new table size");
+static_assert(cosineEaseEntry(0) == (1 << EASE_BITS), "ease must start at 1.0");
+static_assert(cosineEaseEntry(EASE_TABLE_SIZE / 2) == (1 << (EASE_BITS - 1)), "ease must be 0.5 half way");
+static_assert(cosineEaseEntry(EASE_TABLE_SIZE) == 0, "ease must finish at 0.0");
+
+static const uint16_t COSINE_EASE[EASE_TABLE_SIZE + 1] PROGMEM = {
+    EASE_ROW(0), EASE_ROW(8), EASE_ROW(16), EASE_ROW(24),
+    EASE_ROW(32), EASE_ROW(40), EASE_ROW(48), EASE_ROW(56),
+    cosineEaseEntry(EASE_TABLE_SIZE)
+};
+
+uint16_t cosineEase(uint16_t phase) {
+    if (phase >= (1U << EASE_PHASE_BITS)) {
+        return 0;
+    }
+    const uint8_t index = phase >> (EASE_PHASE_BITS - EASE_TABLE_BITS);
+    const uint16_t fraction = phase & ((1U << (EASE_PHASE_BITS - EASE_TABLE_BITS)) - 1);
+    const uint16_t a = pgm_read_word(&COSINE_EASE[index]);
+    const uint16_t b = pgm_read_word(&COSINE_EASE[index + 1]);
+    // The ease only falls, so a >= b.
+    return a - (uint16_t)(((uint32_t)(a - b) * fraction) >> (EASE_PHASE_BITS - EASE_TABLE_BITS));
+}
@@ -0,0 +1,41 @@
+//
+// Easing
+// Cosine ease for joint interpolation from a PROGMEM table, so stepping a move needs no libm
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_EASING_H_
+#define _BITTLEET_EASING_H_
+
+#include <stdint.h>
+
+#define EASE_TABLE_BITS 6
+#define EASE_TABLE_SIZE (1 << EASE_TABLE_BITS) // Segments, the table has one more entry for the end point
+#define EASE_PHASE_BITS 15  // Phase 1.0 is 1 << EASE_PHASE_BITS
+#define EASE_BITS 14        // Ease 1.0 is 1 << EASE_BITS
+
+// Taylor series, only for building the table at compile time. Accurate to well under a Q14 step over [0, pi].
+constexpr double constexprCosSeries(double x2, double term, double sum, int n) {
+    return (n > 12) ? sum : constexprCosSeries(x2, -term * x2 / ((2 * n - 1) * (2 * n)), sum - term * x2 / ((2 * n - 1) * (2 * n)), n + 1);
+}
+
+constexpr double constexprCos(double x) {
+    return constexprCosSeries(x * x, 1.0, 1.0, 1);
+}
+
+constexpr uint16_t cosineEaseEntry(int i) {
+    return (uint16_t)((1.0 + constexprCos(3.14159265358979323846 * i / EASE_TABLE_SIZE)) / 2.0 * (1 << EASE_BITS) + 0.5);
+}
+
+// (1 + cos(pi * phase)) / 2 in Q14, for a Q15 phase from 0 to 1. Linearly interpolated between table entries.
+uint16_t cosineEase(uint16_t phase);
+
+// Phase of step out of steps in Q15. Zero steps is treated as already finished.
+inline uint16_t easePhase(uint16_t step, uint16_t steps) {
+    return (steps == 0 || step >= steps) ? (1U << EASE_PHASE_BITS) : (uint16_t)(((uint32_t)step << EASE_PHASE_BITS) / steps);
+}
+
+#endif // _BITTLEET_EASING_H_
@@ -0,0 +1,112 @@
+//
+// Fast Trigonometry
+// Integer angle maths for the attitude filter, where soft-float libm is too slow on the AVR
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "FastTrig.h"
+#include "Trig.h"
+
+#define ATAN_BITS 15
+#define ATAN_HALF (1L << (ATAN_BITS - 1))
+
+// Abramowitz and Stegun 4.4.49: atan(x) for x in [0, 1] in odd powers to x^9, error under 1e-5 rad. Q15.
+#define ATAN_C1 (32764)  //  0.9998660
+#define ATAN_C3 (-10823) // -0.3302995
+#define ATAN_C5 (5903)   //  0.1801410
+#define ATAN_C7 (-2790)  // -0.0851330
+#define ATAN_C9 (683)    //  0.0208351
+
+#define ATAN_Q15_TO_BINARY_ANGLE (83443) // 2^31 / pi / 2^15, in Q2
+
+// Taylor series of sin(pi/2 * t) for t in [-1, 1] to t^9, error under 4e-6. Q15, so the first term is over one.
+#define SIN_C1 (51472)   //  1.5707963
+#define SIN_C3 (-21167)  // -0.6459641
+#define SIN_C5 (2611)    //  0.0796926
+#define SIN_C7 (-153)    // -0.0046818
+#define SIN_C9 (5)       //  0.0001604
+
+#define Q15_ONE (32767)
+
+// ratio is the smaller coordinate over the larger, in Q15.
+static inline BinaryAngle atanOctant(int32_t ratio) {
+    const int32_t z = (ratio * ratio + ATAN_HALF) >> ATAN_BITS;
+    int32_t p = ATAN_C9;
+    p = ATAN_C7 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    p = ATAN_C5 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    p = ATAN_C3 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    p = ATAN_C1 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    // Back to Q15 before scaling, so the multiply stays in 32 bits; the bits dropped are finer than a Q15 ratio resolves.
+    // Unsigned, since the largest angle times the scale is just over 2^31.
+    const uint32_t angle = ((uint32_t)(ratio * p) + (1UL << (ATAN_BITS - 1))) >> ATAN_BITS;
+    return (BinaryAngle)((angle * ATAN_Q15_TO_BINARY_ANGLE + 2) >> 2);
+}
+
+BinaryAngle atan2Binary(int32_t y, int32_t x) {
+    const uint32_t ax = (x < 0) ? -x : x;
+    const uint32_t ay = (y < 0) ? -y : y;
+    if ((ax == 0) && (ay == 0)) {
+        return 0;
+    }
+    // Unsigned, since pi itself is one past the largest BinaryAngle
+    uint32_t angle;
+    if (ay <= ax) {
+        angle = atanOctant((int32_t)((ay << ATAN_BITS) / ax));
+    } else {
+        angle = BINARY_ANGLE_HALF_PI - atanOctant((int32_t)((ax << ATAN_BITS) / ay));
+    }
+    if (x < 0) {
+        angle = 0x80000000UL - angle;
+    }
+    return (BinaryAngle)((y < 0) ? -angle : angle);
+}
+
+int16_t sinBinary(BinaryAngle a) {
+    // Fold the left half of the circle onto the right, sin(a) = sin(pi - a), again for free by overflow
+    if ((a > BINARY_ANGLE_HALF_PI) || (a < -BINARY_ANGLE_HALF_PI)) {
+        a = (BinaryAngle)(0x80000000UL - (uint32_t)a);
+    }
+    const int32_t t = a >> 15; // Q15 fraction of a right angle
+    const int32_t z = (t * t + ATAN_HALF) >> ATAN_BITS;
+    int32_t p = SIN_C9;
+    p = SIN_C7 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    p = SIN_C5 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    p = SIN_C3 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    p = SIN_C1 + ((p * z + ATAN_HALF) >> ATAN_BITS);
+    const int32_t out = (t * p + ATAN_HALF) >> ATAN_BITS;
+    return (int16_t)((out > Q15_ONE) ? Q15_ONE : ((out < -Q15_ONE) ? -Q15_ONE : out));
+}
+
+// Abramowitz and Stegun 4.4.49 in float, for ratio in [0, 1]
+static inline float atanUnit(float ratio) {
+    const float z = ratio * ratio;
+    return ratio * (0.9998660f + z * (-0.3302995f + z * (0.1801410f + z * (-0.0851330f + z * 0.0208351f))));
+}
+
+float fastAtan2(float y, float x) {
+    const float ax = fabsf(x);
+    const float ay = fabsf(y);
+    if ((ax == 0.0f) && (ay == 0.0f)) {
+        return 0.0f;
+    }
+    float angle = (ay <= ax) ? atanUnit(ay / ax) : (float)(0.5 * M_PI) - atanUnit(ax / ay);
+    if (x < 0.0f) {
+        angle = (float)M_PI - angle;
+    }
+    return (y < 0.0f) ? -angle : angle;
+}
+
+// Taylor series of sin to r^11 over [-pi/2, pi/2], error under 6e-7 before float rounding
+float fastSin(float r) {
+    r = wrapPiToNegPi(r);
+    if (r > (float)(0.5 * M_PI)) {
+        r = (float)M_PI - r;
+    } else if (r < (float)(-0.5 * M_PI)) {
+        r = (float)-M_PI - r;
+    }
+    const float z = r * r;
+    return r * (1.0f + z * (-1.6666667e-1f + z * (8.3333333e-3f + z * (-1.9841270e-4f + z * (2.7557319e-6f + z * -2.5052108e-8f)))));
+}
@@ -0,0 +1,39 @@
+//
+// Fast Trigonometry
+// Polynomial atan2, sin and cos with bounded error, where soft-float libm is too slow on the AVR
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_FASTTRIG_H_
+#define _BITTLEET_FASTTRIG_H_
+
+#include <math.h>
+#include <stdint.h>
+
+// Binary angles: the whole int32 range is one turn, so adding and subtracting wrap to -pi..pi for free.
+typedef int32_t BinaryAngle;
+
+#define BINARY_ANGLE_HALF_PI ((BinaryAngle)0x40000000L)
+#define BINARY_ANGLE_PER_RAD (683565275.576431632f) // 2^31 / pi
+#define RAD_PER_BINARY_ANGLE (1.46291807926715968e-9f) // pi / 2^31
+
+inline float binaryAngleToRadians(BinaryAngle a) { return (float)a * RAD_PER_BINARY_ANGLE; }
+inline BinaryAngle radiansToBinaryAngle(float r) { return (BinaryAngle)(int64_t)(r * BINARY_ANGLE_PER_RAD); }
+
+// atan2 of integer coordinates up to +-65535. Polynomial over one octant, accurate to 1e-4 rad.
+BinaryAngle atan2Binary(int32_t y, int32_t x);
+
+// sin and cos of a binary angle in Q15, accurate to 7e-5. One is returned as 32767.
+int16_t sinBinary(BinaryAngle a);
+inline int16_t cosBinary(BinaryAngle a) { return sinBinary((BinaryAngle)((uint32_t)a + (uint32_t)BINARY_ANGLE_HALF_PI)); }
+
+// Float equivalents of libm's atan2f, sinf and cosf. atan2 is accurate to 2e-5 rad,
+// sin and cos to 1e-6 for angles within a few turns of zero, past which wrapping loses float precision.
+float fastAtan2(float y, float x);
+float fastSin(float r);
+inline float fastCos(float r) { return fastSin(r + (float)(0.5 * M_PI)); }
+
+#endif // _BITTLEET_FASTTRIG_H_
@@ -1,18 +1,76 @@
+//
+// Fixed Point
+// Q format numbers for the motion path, where soft-float is too slow on the AVR
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
 #ifndef _BITTLEET_FIXEDPOINT_H_
 #define _BITTLEET_FIXEDPOINT_H_
 
 #include <stdint.h>
 
+// Intermediate type for products, so a multiply never overflows before it is shifted back down.
+// Only signed types: negation, floor() and saturation all assume a sign bit.
+template <typename T> struct FixedPointWide {
+    static_assert(sizeof(T) == 0, "FixedPoint only supports int8_t, int16_t and int32_t");
+};
+template <> struct FixedPointWide<int8_t> { typedef int16_t Type; };
+template <> struct FixedPointWide<int16_t> { typedef int32_t Type; };
+template <> struct FixedPointWide<int32_t> { typedef int64_t Type; };
+
 template <typename T, int BITS>
 class FixedPoint {
 public:
+    static_assert((T)-1 < (T)0, "FixedPoint needs a signed raw type");
+    typedef typename FixedPointWide<T>::Type Wide;
+
     FixedPoint() = default;
     FixedPoint(float value) : _value(value * _denominator) {}
 
-    float toF32() { return ((float)_value)/_denominator;}
+    static FixedPoint fromRaw(T raw) { FixedPoint out; out._value = raw; return out; }
+    static FixedPoint fromInt(int value) { return fromRaw((T)((Wide)value << BITS)); }
+
+    float toF32() const { return ((float)_value)/_denominator;}
+    T raw() const { return _value; }
+
+    // Rounds towards negative infinity, the same as an arithmetic shift.
+    int16_t floor() const { return _toInt16((Wide)_value >> BITS); }
+    // Rounds towards zero, the same as a float to int conversion. Negated in Wide so the most negative value is safe.
+    int16_t truncate() const { return _toInt16((_value < 0) ? -((-(Wide)_value) >> BITS) : ((Wide)_value >> BITS)); }
+
+    FixedPoint operator+(FixedPoint other) const { return fromRaw(_value + other._value); }
+    FixedPoint operator-(FixedPoint other) const { return fromRaw(_value - other._value); }
+    FixedPoint operator-() const { return fromRaw(-_value); }
+    FixedPoint& operator+=(FixedPoint other) { _value += other._value; return *this; }
+    FixedPoint& operator-=(FixedPoint other) { _value -= other._value; return *this; }
+
+    // Both multiplies saturate, since a product easily leaves the range of T.
+    FixedPoint operator*(FixedPoint other) const { return fromRaw(_saturate(((Wide)_value * other._value) >> BITS)); }
+    FixedPoint operator*(int other) const { return fromRaw(_saturate((Wide)_value * other)); }
+
+    // Product in the raw wide type with BITS + OTHER fractional bits, for callers which want to pick their own rounding.
+    template <typename U, int OTHER>
+    Wide multiplyWide(FixedPoint<U, OTHER> other) const { return (Wide)_value * other.raw(); }
+
+    bool operator==(FixedPoint other) const { return _value == other._value; }
+    bool operator!=(FixedPoint other) const { return _value != other._value; }
+    bool operator<(FixedPoint other) const { return _value < other._value; }
+    bool operator>(FixedPoint other) const { return _value > other._value; }
+    bool operator<=(FixedPoint other) const { return _value <= other._value; }
+    bool operator>=(FixedPoint other) const { return _value >= other._value; }
+
 private:
+    static constexpr Wide _max = (Wide)(((Wide)1 << (sizeof(T) * 8 - 1)) - 1);
+    static constexpr Wide _min = -_max - 1;
+
+    static T _saturate(Wide value) { return (value > _max) ? (T)_max : ((value < _min) ? (T)_min : (T)value); }
+    static int16_t _toInt16(Wide value) { return (value > INT16_MAX) ? INT16_MAX : ((value < INT16_MIN) ? INT16_MIN : (int16_t)value); }
+
     T _value = 0;
-    static constexpr float _denominator = (float)(1 << BITS);
+    static constexpr float _denominator = (float)(1L << BITS);
 };
 
 
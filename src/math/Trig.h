@@ -10,17 +10,15 @@
 #ifndef _BITTLEET_TRIG_H_
 #define _BITTLEET_TRIG_H_
 
+#include <math.h>
+
 #define M_DEG2RAD (M_PI / 180.0)
 #define M_RAD2DEG (180.0 / M_PI)
 
+// Removes whole turns in one step, rather than looping once per turn. Angles already in -pi..pi come back unchanged,
+// except -pi itself, which comes back as pi.
 inline float wrapPiToNegPi(float v){
-    while (v > M_PI) {
-        v -= (float)(2.0 * M_PI);
-    }
-    while (v < -M_PI) {
-        v += (float)(2.0 * M_PI);
-    }
-    return v;
+    return v - (float)(2.0 * M_PI) * ceilf(v * (float)(0.5 * M_1_PI) - 0.5f);
 }
 
 // Return the shortest path from a to b
@@ -15,6 +15,10 @@
 
 namespace Scheduler {
 
+// Called with the microseconds of slack before the next task is due.
+// It should return well within that time; any overrun just delays the next task.
+typedef void (*IdleTask)(uint32_t slackUs);
+
 template <int NTasks>
 class Scheduler {
   public:
@@ -32,6 +36,8 @@ class Scheduler {
         return _registeredTasks++;
     }
 
+    void setIdleTask(IdleTask task) { _idleTask = task; }
+
     int waitUntilNextTask(){
         if (_firstRun){
             _handleFirstRun();
@@ -46,6 +52,7 @@ class Scheduler {
     uint32_t _periodUs[NTasks];
     int _registeredTasks = 0;
     bool _firstRun = true;
+    IdleTask _idleTask = nullptr;
 
     void _handleFirstRun() {
         uint32_t currentUs = micros();
@@ -76,6 +83,10 @@ class Scheduler {
                 _nextUpdateUs[index] = micros();
             }
         } else {
+            if (_idleTask != nullptr) {
+                _idleTask(deltaUs);
+                deltaUs = _nextUpdateUs[index] - micros();
+            }
             while(deltaUs > 10000){
                 delayMicroseconds(10000);
                 deltaUs = _nextUpdateUs[index] - micros();
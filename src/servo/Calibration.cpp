@@ -0,0 +1,64 @@
+//
+// Servo Calibration
+// RAM copy of the per-joint servo calibration held in the on-board EEPROM
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Calibration.h"
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+namespace Servo {
+
+void Calibration::load() {
+    const int16_t dutyRange = _dutyMax - _dutyMin;
+    for (uint8_t i = 0; i < DOF; i++) {
+        Joint& joint = _joints[i];
+        joint.pin = (uint8_t)EEPROM.read(PIN + i);
+        joint.calib = (int8_t)EEPROM.read(CALIB + i);
+        joint.middleShift = (int8_t)EEPROM.read(MID_SHIFT + i);
+        joint.direction = (int8_t)EEPROM.read(ROTATION_DIRECTION + i);
+        for (uint8_t p = 0; p < NUM_ADAPT_PARAM; p++) {
+            joint.adaptive[p] = (int8_t)EEPROM.read(ADAPT_PARAM + i * NUM_ADAPT_PARAM + p);
+        }
+        const uint8_t range = (uint8_t)EEPROM.read(SERVO_ANGLE_RANGE + i);
+        joint.pulsePerDegree = (range == 0) ? 0.0f : float(dutyRange) / range * joint.direction;
+        const float rounding = (joint.pulsePerDegree < 0.0f) ? -0.5f : 0.5f;
+        joint.pulsePerDegreeFixed = PulsePerDegree::fromRaw(joint.pulsePerDegree * (1 << SERVO_PULSE_BITS) + rounding);
+        _updateDuty0(i);
+    }
+}
+
+void Calibration::save() {
+    for (uint8_t i = 0; i < DOF; i++) {
+        EEPROM.update(CALIB + i, _joints[i].calib);
+    }
+}
+
+void Calibration::setCalib(uint8_t i, int8_t calib) {
+    _joints[i].calib = calib;
+    _updateDuty0(i);
+}
+
+void Calibration::_updateDuty0(uint8_t i) {
+    Joint& joint = _joints[i];
+    joint.duty0 = _dutyMin + (_dutyMax - _dutyMin) / 2 + float(joint.middleShift + joint.calib) * joint.pulsePerDegree;
+}
+
+int16_t Calibration::duty(uint8_t i, float angle) const {
+    const int16_t duty = _joints[i].duty0 + angle * _joints[i].pulsePerDegree;
+    return (duty < _dutyMin) ? _dutyMin : (duty > _dutyMax) ? _dutyMax : duty;
+}
+
+int16_t Calibration::duty(uint8_t i, Angle angle) const {
+    // The float duty truncates, but duties are positive so flooring the pulses matches it.
+    const int32_t pulses = angle.multiplyWide(_joints[i].pulsePerDegreeFixed);
+    const int16_t duty = _joints[i].duty0 + (int16_t)(pulses >> (SERVO_ANGLE_BITS + SERVO_PULSE_BITS));
+    return (duty < _dutyMin) ? _dutyMin : (duty > _dutyMax) ? _dutyMax : duty;
+}
+
+} // namespace Servo
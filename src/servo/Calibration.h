@@ -0,0 +1,73 @@
+//
+// Servo Calibration
+// RAM copy of the per-joint servo calibration held in the on-board EEPROM
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SERVO_CALIBRATION_H_
+#define _BITTLEET_SERVO_CALIBRATION_H_
+
+#include <stdint.h>
+#include "../Bittle.h"
+#include "../math/FixedPoint.h"
+
+// On-board EEPROM addresses of the calibration arrays, one entry per joint
+#define PIN 0                 // 16 byte array
+#define CALIB 16              // 16 byte array
+#define MID_SHIFT 32          // 16 byte array
+#define ROTATION_DIRECTION 48 // 16 byte array
+#define SERVO_ANGLE_RANGE 64  // 16 byte array
+#define ADAPT_PARAM 160          // 16 x NUM_ADAPT_PARAM byte array
+#define NUM_ADAPT_PARAM  2    // number of parameters for adaption
+
+// Fixed point duty path. Q9.6 angles cover +/-512 degrees, which leaves room for double angle skills plus
+// attitude adjustment. Q5.10 pulses per degree cover +/-32 counts per degree, servos use around 10.
+#define SERVO_ANGLE_BITS 6
+#define SERVO_PULSE_BITS 10
+
+namespace Servo {
+
+typedef FixedPoint<int16_t, SERVO_ANGLE_BITS> Angle;
+typedef FixedPoint<int16_t, SERVO_PULSE_BITS> PulsePerDegree;
+
+struct Joint {
+    uint8_t pin;
+    int8_t middleShift;
+    int8_t direction;
+    int8_t calib;
+    int8_t adaptive[NUM_ADAPT_PARAM];
+    int16_t duty0;          // Duty at zero degrees, with middle shift and calibration applied
+    float pulsePerDegree;   // Signed by the rotation direction
+    PulsePerDegree pulsePerDegreeFixed;
+};
+
+// Loaded once at boot so the motion task never has to touch the EEPROM.
+class Calibration {
+  public:
+    Calibration(int16_t dutyMin, int16_t dutyMax) : _dutyMin(dutyMin), _dutyMax(dutyMax) {};
+
+    void load();
+    void save(); // Writes back the calibration offsets, only touching bytes which changed.
+
+    // Applies immediately, but is only kept over a reboot once saved.
+    void setCalib(uint8_t i, int8_t calib);
+
+    const Joint& joint(uint8_t i) const { return _joints[i]; }
+    int16_t duty(uint8_t i, float angle) const;
+    // Integer only, within one count of the float duty.
+    int16_t duty(uint8_t i, Angle angle) const;
+
+  protected:
+    void _updateDuty0(uint8_t i);
+
+    Joint _joints[DOF];
+    int16_t _dutyMin;
+    int16_t _dutyMax;
+};
+
+}
+
+#endif // _BITTLEET_SERVO_CALIBRATION_H_
@@ -0,0 +1,105 @@
+//
+// Servo Frame
+// Buffers a tick of servo duties and commits them to the PCA9685 in auto-increment bursts
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Frame.h"
+
+#include <Arduino.h>
+#include <Wire.h>
+
+namespace Servo {
+
+void Frame::begin() {
+    Wire.beginTransmission(_address);
+    Wire.write(PCA9685_MODE1);
+    Wire.endTransmission();
+    Wire.requestFrom(_address, (uint8_t)1);
+    const uint8_t mode = (uint8_t)Wire.read();
+    if ((mode & PCA9685_MODE1_AI) == 0) {
+        Wire.beginTransmission(_address);
+        Wire.write(PCA9685_MODE1);
+        Wire.write(mode | PCA9685_MODE1_AI);
+        Wire.endTransmission();
+    }
+    invalidate();
+}
+
+void Frame::set(uint8_t channel, uint16_t duty) {
+    if (channel >= PCA9685_CHANNELS) {
+        return;
+    }
+    const uint16_t mask = (uint16_t)1u << channel;
+    _duty[channel] = duty;
+    if ((_committed & mask) && (_sent[channel] == duty)) {
+        _pending &= ~mask;
+        _unchanged++;
+    } else {
+        _pending |= mask;
+    }
+}
+
+uint8_t Frame::commit() {
+    if (_pending == 0) {
+        _lastCommitUs = 0;
+        _lastBursts = 0;
+        return 0;
+    }
+    const uint32_t start = micros();
+    uint8_t bursts = 0;
+    uint8_t channel = 0;
+    while (channel < PCA9685_CHANNELS) {
+        if ((_pending & ((uint16_t)1u << channel)) == 0) {
+            channel++;
+            continue;
+        }
+        uint8_t count = 1;
+        while ((channel + count < PCA9685_CHANNELS) &&
+               (count < SERVO_BURST_CHANNELS) &&
+               (_pending & ((uint16_t)1u << (channel + count)))) {
+            count++;
+        }
+        _writeBurst(channel, count);
+        for (uint8_t c = channel; c < channel + count; c++) {
+            _sent[c] = _duty[c];
+        }
+        bursts++;
+        channel += count;
+    }
+    _committed |= _pending;
+    _pending = 0;
+
+    _lastCommitUs = micros() - start;
+    if (_lastCommitUs > _maxCommitUs) {
+        _maxCommitUs = _lastCommitUs;
+    }
+    _lastBursts = bursts;
+    _commits++;
+    return bursts;
+}
+
+void Frame::resetStats() {
+    _lastCommitUs = 0;
+    _maxCommitUs = 0;
+    _lastBursts = 0;
+    _commits = 0;
+    _unchanged = 0;
+}
+
+void Frame::_writeBurst(uint8_t first, uint8_t count) {
+    Wire.beginTransmission(_address);
+    Wire.write(PCA9685_LED0_ON_L + PCA9685_CHANNEL_BYTES * first);
+    for (uint8_t c = first; c < first + count; c++) {
+        Wire.write(0); // Every channel turns on at the start of the period
+        Wire.write(0);
+        Wire.write(_duty[c] & 0xff);
+        Wire.write(_duty[c] >> 8);
+    }
+    Wire.endTransmission();
+}
+
+} // namespace Servo
@@ -0,0 +1,73 @@
+//
+// Servo Frame
+// Buffers a tick of servo duties and commits them to the PCA9685 in auto-increment bursts
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SERVO_FRAME_H_
+#define _BITTLEET_SERVO_FRAME_H_
+
+#include <stdint.h>
+
+#define PCA9685_ADDRESS 0x40
+#define PCA9685_MODE1 0x00
+#define PCA9685_MODE1_AI 0x20       // Register auto-increment
+#define PCA9685_LED0_ON_L 0x06
+#define PCA9685_CHANNELS 16
+#define PCA9685_CHANNEL_BYTES 4     // ON_L, ON_H, OFF_L, OFF_H
+#define PCA9685_FULL_OFF 4096       // Sets the full off bit in OFF_H
+
+#define SERVO_WIRE_BUFFER 32        // Wire BUFFER_LENGTH on the AVR, including the register address
+#define SERVO_BURST_CHANNELS ((SERVO_WIRE_BUFFER - 1) / PCA9685_CHANNEL_BYTES)
+
+namespace Servo {
+
+// Channels set during a tick are only sent on commit. Runs of neighbouring channels go out as a
+// single transmission, so a full body pose is three bursts rather than sixteen transactions.
+// The last committed duty of each channel is kept, so channels which have not changed are not sent at all.
+class Frame {
+  public:
+    Frame(uint8_t address = PCA9685_ADDRESS) : _address(address) {};
+
+    // The Adafruit driver turns auto-increment on when setting the frequency, but make sure of it.
+    void begin();
+
+    void set(uint8_t channel, uint16_t duty);
+    uint16_t duty(uint8_t channel) const { return _duty[channel]; }
+    bool pending() const { return _pending != 0; }
+
+    // Forget what the PCA9685 holds, so every channel set is sent on the next commit.
+    void invalidate() { _committed = 0; }
+
+    // Returns the number of bursts written.
+    uint8_t commit();
+
+    uint32_t lastCommitUs() const { return _lastCommitUs; }
+    uint32_t maxCommitUs() const { return _maxCommitUs; }
+    uint8_t lastBursts() const { return _lastBursts; }
+    uint32_t commits() const { return _commits; }
+    uint32_t unchanged() const { return _unchanged; } // Sets which matched the committed duty
+    void resetStats();
+
+  protected:
+    void _writeBurst(uint8_t first, uint8_t count);
+
+    uint8_t _address;
+    uint16_t _duty[PCA9685_CHANNELS] = {};
+    uint16_t _pending = 0;
+    uint16_t _sent[PCA9685_CHANNELS] = {};
+    uint16_t _committed = 0; // Channels where _sent is what the PCA9685 holds
+
+    uint32_t _lastCommitUs = 0;
+    uint32_t _maxCommitUs = 0;
+    uint8_t _lastBursts = 0;
+    uint32_t _commits = 0;
+    uint32_t _unchanged = 0;
+};
+
+}
+
+#endif // _BITTLEET_SERVO_FRAME_H_
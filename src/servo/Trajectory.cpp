@@ -0,0 +1,66 @@
+//
+// Servo Trajectory
+// Cosine eased joint interpolation, advanced at the pace of the old blocking loop
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Trajectory.h"
+
+#include <Arduino.h>
+
+namespace Servo {
+
+void Trajectory::_begin(const int16_t* current, float speedRatio, uint8_t offset) {
+    _offset = offset;
+    int16_t maxDiff = 0;
+    for (uint8_t i = offset; i < DOF; i++) {
+        _diff[i] = current[i] - _target[i];
+        const int16_t diff = abs(_diff[i]);
+        maxDiff = (diff > maxDiff) ? diff : maxDiff;
+    }
+
+    _steps = 0;
+    if (speedRatio > 0.0f) {
+        const float steps = round(maxDiff / speedRatio);
+        _steps = (steps > TRAJECTORY_MAX_STEPS) ? TRAJECTORY_MAX_STEPS : (uint8_t)steps;
+    }
+    _count = (_steps == 0) ? 1 : _steps;
+    _step = 0;
+}
+
+bool Trajectory::step(Angle* angles) {
+    if (!active()) {
+        return false;
+    }
+    _step++;
+    _write(angles);
+    return true;
+}
+
+bool Trajectory::step(Angle* angles, uint32_t now) {
+    if (!active()) {
+        return false;
+    }
+    if (_step == 0) {
+        _start = now;
+    }
+    const uint32_t due = (now - _start) / TRAJECTORY_STEP_MICROS + 1;
+    if (due <= _step) {
+        return false;
+    }
+    _step = (due >= _count) ? _count : (uint8_t)due;
+    _write(angles);
+    return true;
+}
+
+void Trajectory::_write(Angle* angles) const {
+    const EaseRatio ease = EaseRatio::fromRaw(cosineEase(easePhase(_step, _steps)));
+    for (uint8_t i = _offset; i < DOF; i++) {
+        angles[i] = easedAngle(_target[i], _diff[i], ease);
+    }
+}
+
+} // namespace Servo
@@ -0,0 +1,76 @@
+//
+// Servo Trajectory
+// Cosine eased joint interpolation, advanced at the pace of the old blocking loop
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SERVO_TRAJECTORY_H_
+#define _BITTLEET_SERVO_TRAJECTORY_H_
+
+#include <stdint.h>
+#include "../Bittle.h"
+#include "../math/FixedPoint.h"
+#include "../math/Easing.h"
+#include "Calibration.h"
+
+#define SERVO_EASE_BITS EASE_BITS
+#define TRAJECTORY_MAX_STEPS 255
+// Time the blocking transform() loop took per step, writing every joint's PWM over I2C.
+#define TRAJECTORY_STEP_MICROS 2500
+
+namespace Servo {
+
+// Fraction of the difference still to travel, 1.0 at the start of an interpolation and 0.0 at the end.
+typedef FixedPoint<int16_t, SERVO_EASE_BITS> EaseRatio;
+
+// The ease is looked up once per step, so each joint is integer only.
+inline Angle easedAngle(int16_t target, int16_t diff, EaseRatio ease) {
+    return Angle::fromInt(target) + Angle::fromRaw((int16_t)(((int32_t)ease.raw() * diff) >> (SERVO_EASE_BITS - SERVO_ANGLE_BITS)));
+}
+
+// Replaces the blocking transform() loop. The step count is the same: the joint with the furthest to go
+// moves speedRatio degrees per step, and a speedRatio of zero goes straight to the target.
+// The step which would only repeat the current pose is skipped.
+// Motion ticks are far longer than a step, so the timed step() skips ahead to the step due at that time.
+class Trajectory {
+  public:
+    Trajectory() = default;
+
+    template <typename T>
+    void begin(const int16_t* current, const T* target, uint8_t angleDataRatio = 1, float speedRatio = 1, uint8_t offset = 0) {
+        for (uint8_t i = offset; i < DOF; i++) {
+            _target[i] = target[i - offset] * angleDataRatio;
+        }
+        _begin(current, speedRatio, offset);
+    }
+
+    // Writes the angles of joints offset to DOF - 1. Returns false once the target has been reached.
+    bool step(Angle* angles);
+    // As above, but moves on to the step due at now, timed from the first call. Returns false when no step is due.
+    bool step(Angle* angles, uint32_t now);
+    void stop() { _step = _count; }
+
+    bool active() const { return _step < _count; }
+    uint8_t offset() const { return _offset; }
+    uint8_t steps() const { return _count; }
+    uint8_t remaining() const { return _count - _step; }
+
+  protected:
+    void _begin(const int16_t* current, float speedRatio, uint8_t offset);
+    void _write(Angle* angles) const;
+
+    int16_t _target[DOF] = {};
+    int16_t _diff[DOF] = {};
+    uint8_t _offset = 0;
+    uint8_t _steps = 0;     // Interpolation steps, zero for a jump
+    uint8_t _count = 0;     // Ticks to reach the target
+    uint8_t _step = 0;
+    uint32_t _start = 0;
+};
+
+}
+
+#endif // _BITTLEET_SERVO_TRAJECTORY_H_
@@ -0,0 +1,51 @@
+//
+// Bittle Skill Arena
+// Fixed capacity bump allocator for skill data
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_ARENA_H_
+#define _BITTLEET_SKILL_ARENA_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Skill {
+
+// Storage is statically sized so skill loads never touch the heap.
+// Allocations are only released all at once with reset().
+template <uint16_t SIZE>
+class Arena {
+  public:
+    Arena() = default;
+
+    char* allocate(uint16_t length) {
+        if (length > (SIZE - _used)) {
+            return NULL;
+        }
+        char* result = &_data[_used];
+        _used += length;
+        if (_used > _highWatermark) {
+            _highWatermark = _used;
+        }
+        return result;
+    }
+
+    void reset() { _used = 0; }
+
+    uint16_t used() const { return _used; }
+    uint16_t highWatermark() const { return _highWatermark; }
+    static constexpr uint16_t capacity() { return SIZE; }
+
+  protected:
+    char _data[SIZE];
+    uint16_t _used = 0;
+    uint16_t _highWatermark = 0;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_ARENA_H_
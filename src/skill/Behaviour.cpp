@@ -0,0 +1,91 @@
+//
+// Bittle Behaviour Executor
+// Plays a behaviour skill a step at a time from the motion task
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Behaviour.h"
+
+#include <Arduino.h>
+#include "../math/Trig.h"
+
+namespace Skill {
+
+void Behaviour::begin(const Skill& skill) {
+    _skill = &skill;
+    _index = 0;
+    _repeat = skill.loopSpec.count - 1;
+    _state = (skill.type == Type::Behaviour && skill.frames > 0) ? State::Start : State::Idle;
+}
+
+Behaviour::Action Behaviour::step(uint32_t nowUs, bool moving, float axisAngle) {
+    switch (_state) {
+        case State::Idle: {
+            return Action::None;
+        }
+        case State::Start: {
+            _skill->copyFrame(_index, _frame);
+            _state = State::Moving;
+            return Action::Move;
+        }
+        case State::Moving: {
+            if (moving) {
+                return Action::None;
+            }
+            _waitStartUs = nowUs;
+            if (_frame[BEHAVIOUR_TRIGGER_AXIS] != 0) {
+                _previousAngle = axisAngle;
+                _state = State::Triggering;
+                return Action::None;
+            }
+            _state = State::Delaying;
+            return (_frame[BEHAVIOUR_DELAY] == 0) ? _next() : Action::None;
+        }
+        case State::Delaying: {
+            if ((nowUs - _waitStartUs) < (uint8_t)_frame[BEHAVIOUR_DELAY] * BEHAVIOUR_DELAY_UNIT_US) {
+                return Action::None;
+            }
+            return _next();
+        }
+        case State::Triggering: {
+            const int8_t axis = _frame[BEHAVIOUR_TRIGGER_AXIS];
+            const float triggerAngle = (float)_frame[BEHAVIOUR_TRIGGER_ANGLE] * M_DEG2RAD;
+            // Skip the reading where the angle jumps from 180 to -180. The sign of the axis decides whether
+            // the angle has to rise or fall through the trigger angle.
+            const bool crossed = (M_PI - fabs(axisAngle) > 2.0) &&
+                                 (axis * axisAngle < axis * triggerAngle) &&
+                                 (axis * _previousAngle > axis * triggerAngle);
+            _previousAngle = axisAngle;
+            if (crossed) {
+                return _next();
+            }
+            if ((nowUs - _waitStartUs) >= BEHAVIOUR_TRIGGER_TIMEOUT_US) {
+                _timeouts++;
+                return _next();
+            }
+            return Action::None;
+        }
+    }
+    return Action::None;
+}
+
+Behaviour::Action Behaviour::_next() {
+    if (_index == _skill->loopSpec.finalRow && _repeat > 0) {
+        _index = _skill->loopSpec.firstRow;
+        _repeat--;
+    } else {
+        _index++;
+    }
+    if (_index >= _skill->frames) {
+        _state = State::Idle;
+        return Action::Done;
+    }
+    _skill->copyFrame(_index, _frame);
+    _state = State::Moving;
+    return Action::Move;
+}
+
+} // namespace Skill
@@ -0,0 +1,77 @@
+//
+// Bittle Behaviour Executor
+// Plays a behaviour skill a step at a time from the motion task
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_BEHAVIOUR_H_
+#define _BITTLEET_SKILL_BEHAVIOUR_H_
+
+#include <stdint.h>
+#include "../Bittle.h"
+#include "Skill.h"
+
+#define BEHAVIOUR_FRAME_SIZE (DOF + 4)   // Matches Skill::frameSize()
+#define BEHAVIOUR_SPEED (DOF)           // Degrees per step, in quarters
+#define BEHAVIOUR_DELAY (DOF + 1)       // Wait after the move, in 50ms units
+#define BEHAVIOUR_TRIGGER_AXIS (DOF + 2) // Signed, zero for a timed wait
+#define BEHAVIOUR_TRIGGER_ANGLE (DOF + 3) // Degrees
+#define BEHAVIOUR_DELAY_UNIT_US (50000UL)
+#define BEHAVIOUR_TRIGGER_TIMEOUT_US (3000000UL) // Give up waiting on the attitude, rather than hang the robot
+
+namespace Skill {
+
+// Each frame is a move, then either a timed wait or a wait for the body to rotate through the trigger angle.
+// None of the waits block; step() is called every motion tick and says when the next move should start.
+class Behaviour {
+  public:
+    enum class Action : uint8_t {
+        None,   // Keep moving or waiting
+        Move,   // Start moving to frame()
+        Done,
+    };
+
+    Behaviour() = default;
+
+    // The skill must stay loaded until the behaviour is done or aborted.
+    void begin(const Skill& skill);
+    void abort() { _state = State::Idle; }
+
+    // moving is true while the last move is still under way. axisAngle is the attitude about triggerAxis(), in radians.
+    Action step(uint32_t nowUs, bool moving, float axisAngle);
+
+    bool active() const { return _state != State::Idle; }
+    const char* frame() const { return _frame; }
+    uint8_t frameIndex() const { return _index; }
+    uint8_t angleMultiplier() const { return _skill->doubleAngles ? 2 : 1; }
+    float speedRatio() const { return _frame[BEHAVIOUR_SPEED] / 4.0f; }
+    int8_t triggerAxis() const { return _frame[BEHAVIOUR_TRIGGER_AXIS]; }
+    uint16_t timeouts() const { return _timeouts; }
+
+  protected:
+    enum class State : uint8_t {
+        Idle,
+        Start,
+        Moving,
+        Delaying,
+        Triggering,
+    };
+
+    Action _next();
+
+    const Skill* _skill = nullptr;
+    State _state = State::Idle;
+    uint8_t _index = 0;
+    int8_t _repeat = 0;
+    char _frame[BEHAVIOUR_FRAME_SIZE] = {};
+    uint32_t _waitStartUs = 0;
+    float _previousAngle = 0.0f;
+    uint16_t _timeouts = 0;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_BEHAVIOUR_H_
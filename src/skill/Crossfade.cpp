@@ -0,0 +1,69 @@
+//
+// Bittle Gait Crossfade
+// Blends one gait into the next at the same point in the cycle, instead of stopping to change
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Crossfade.h"
+
+namespace Skill {
+
+void Crossfade::begin(const Skill& from, uint8_t frameIndex) {
+    if ((from.type != Type::Gait) || (from.frames == 0)) {
+        stop();
+        return;
+    }
+    _fromFrames = from.frames;
+    _fromIndex = frameIndex % from.frames;
+    _fromMultiplier = from.doubleAngles ? 2 : 1;
+    for (uint8_t f = 0; f < CROSSFADE_FRAMES; f++) {
+        from.copyFrame((_fromIndex + f) % _fromFrames, _frames[f]);
+    }
+    _played = 0;
+    _step = 0;
+}
+
+uint8_t Crossfade::alignedFrame(uint8_t frames) const {
+    if ((frames == 0) || (_fromFrames == 0)) {
+        return 0;
+    }
+    const uint16_t position = (_fromIndex + _played) % _fromFrames;
+    return (uint8_t)(((position * frames + _fromFrames / 2) / _fromFrames) % frames);
+}
+
+void Crossfade::hold(Servo::Angle* angles) {
+    const char* frame = _oldFrame();
+    for (uint8_t i = 0; i < WALKING_DOF; i++) {
+        angles[i] = Servo::Angle::fromInt(frame[i] * _fromMultiplier);
+    }
+    if (_played < CROSSFADE_FRAMES) {
+        _played++;
+    }
+}
+
+bool Crossfade::step(const Skill& to, uint8_t frameIndex, Servo::Angle* angles) {
+    if (!active()) {
+        return false;
+    }
+    _step++;
+    const Servo::EaseRatio ease = Servo::EaseRatio::fromRaw(cosineEase(easePhase(_step, CROSSFADE_STEPS)));
+    const char* frame = _oldFrame();
+    const int8_t multiplier = to.doubleAngles ? 2 : 1;
+    for (uint8_t i = 0; i < WALKING_DOF; i++) {
+        const int16_t target = to.angle(frameIndex, i) * multiplier;
+        angles[i] = Servo::easedAngle(target, frame[i] * _fromMultiplier - target, ease);
+    }
+    if (_played < CROSSFADE_FRAMES) {
+        _played++;
+    }
+    return true;
+}
+
+const char* Crossfade::_oldFrame() const {
+    return _frames[(_played < CROSSFADE_FRAMES) ? _played : CROSSFADE_FRAMES - 1];
+}
+
+} // namespace Skill
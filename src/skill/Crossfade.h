@@ -0,0 +1,59 @@
+//
+// Bittle Gait Crossfade
+// Blends one gait into the next at the same point in the cycle, instead of stopping to change
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_CROSSFADE_H_
+#define _BITTLEET_SKILL_CROSSFADE_H_
+
+#include <stdint.h>
+#include "../Bittle.h"
+#include "../servo/Trajectory.h"
+#include "Skill.h"
+
+#define CROSSFADE_FRAMES (6) // Old gait frames kept, enough to keep walking while the next gait loads
+#define CROSSFADE_STEPS (4)  // Frames over which the old gait fades out
+
+namespace Skill {
+
+// The old gait is usually streamed through the same buffer the next gait will be loaded into,
+// so begin() copies the frames it would have played next before the load starts.
+// hold() keeps walking on those frames while loading, then step() fades from them to the next gait.
+// Gaits are assumed to start their cycle at the same leg phase, so alignedFrame() maps between them by fraction of the cycle.
+class Crossfade {
+  public:
+    Crossfade() = default;
+
+    // frameIndex is the next frame the old gait would have played.
+    void begin(const Skill& from, uint8_t frameIndex);
+    void stop() { _step = CROSSFADE_STEPS; }
+
+    bool active() const { return _step < CROSSFADE_STEPS; }
+
+    // The frame of a gait with this many frames at the same point in the cycle as the old gait is now.
+    uint8_t alignedFrame(uint8_t frames) const;
+
+    // Writes the next old gait frame for the WALKING_DOF joints. Holds the last frame kept if the load outlasts them.
+    void hold(Servo::Angle* angles);
+
+    // Writes the blend of the next old gait frame and frame frameIndex of the new gait. Returns false once faded out.
+    bool step(const Skill& to, uint8_t frameIndex, Servo::Angle* angles);
+
+  protected:
+    const char* _oldFrame() const;
+
+    char _frames[CROSSFADE_FRAMES][WALKING_DOF] = {};
+    uint8_t _fromFrames = 0;
+    uint8_t _fromIndex = 0;
+    uint8_t _fromMultiplier = 1;
+    uint8_t _played = 0;
+    uint8_t _step = CROSSFADE_STEPS;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_CROSSFADE_H_
@@ -0,0 +1,107 @@
+//
+// Bittle Skill Delta Coding
+// Compact encoding for skill frames, which change little from one frame to the next
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Delta.h"
+
+#define DELTA_ESCAPE (0x8)
+#define DELTA_NIBBLE_MIN (-7)
+#define DELTA_NIBBLE_MAX (7)
+
+namespace Skill {
+
+void DeltaDecoder::begin(char* out, uint16_t length, uint8_t frameSize) {
+    _out = out;
+    _length = length;
+    _index = 0;
+    _frameSize = frameSize;
+    _escaped = 0;
+    _raw = 0;
+}
+
+void DeltaDecoder::_put(uint8_t difference) {
+    if (_index >= _length) {
+        return;
+    }
+    const uint8_t previous = (_index >= _frameSize) ? (uint8_t)_out[_index - _frameSize] : 0;
+    _out[_index] = (char)(uint8_t)(previous + difference);
+    _index++;
+}
+
+void DeltaDecoder::_nibble(uint8_t nibble) {
+    switch (_escaped) {
+        case 0: {
+            if (nibble == DELTA_ESCAPE) {
+                _escaped = 1;
+            } else {
+                _put((nibble & 0x08) ? (nibble | 0xF0) : nibble); // Sign extend
+            }
+            break;
+        }
+        case 1: {
+            _raw = nibble << 4;
+            _escaped = 2;
+            break;
+        }
+        default: {
+            _put(_raw | nibble);
+            _escaped = 0;
+            break;
+        }
+    }
+}
+
+uint16_t DeltaDecoder::decode(const char* in, uint16_t len) {
+    uint16_t used = 0;
+    while ((used < len) && !done()) {
+        const uint8_t packed = (uint8_t)in[used++];
+        _nibble(packed >> 4);
+        _nibble(packed & 0x0F);
+    }
+    return used;
+}
+
+static bool putNibble(char* out, uint16_t& nibbles, uint16_t capacity, uint8_t nibble) {
+    if (nibbles / 2 >= capacity) {
+        return false;
+    }
+    char& packed = out[nibbles / 2];
+    if ((nibbles & 1) == 0) {
+        packed = (char)(nibble << 4);
+    } else {
+        packed = (char)((uint8_t)packed | nibble);
+    }
+    nibbles++;
+    return true;
+}
+
+uint16_t deltaEncode(const char* spec, uint16_t length, uint8_t frameSize, char* out, uint16_t capacity) {
+    uint16_t nibbles = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        const uint8_t previous = (i >= frameSize) ? (uint8_t)spec[i - frameSize] : 0;
+        const uint8_t difference = (uint8_t)spec[i] - previous;
+        const int8_t d = (int8_t)difference;
+        bool ok;
+        if ((d >= DELTA_NIBBLE_MIN) && (d <= DELTA_NIBBLE_MAX)) {
+            ok = putNibble(out, nibbles, capacity, difference & 0x0F);
+        } else {
+            ok = putNibble(out, nibbles, capacity, DELTA_ESCAPE) &&
+                putNibble(out, nibbles, capacity, difference >> 4) &&
+                putNibble(out, nibbles, capacity, difference & 0x0F);
+        }
+        if (!ok) {
+            return 0;
+        }
+    }
+    if ((nibbles & 1) && !putNibble(out, nibbles, capacity, 0)) {
+        return 0;
+    }
+    return nibbles / 2;
+}
+
+} // namespace Skill
@@ -0,0 +1,61 @@
+//
+// Bittle Skill Delta Coding
+// Compact encoding for skill frames, which change little from one frame to the next
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_DELTA_H_
+#define _BITTLEET_SKILL_DELTA_H_
+
+#include <stdint.h>
+
+// Set in the angle ratio byte of the skill header (header[3]) when the frames are delta coded.
+// A compressed skill has a two byte little endian packed length after the headers, then the packed frames.
+#define SKILL_DELTA_FLAG (0x80)
+#define SKILL_DELTA_LENGTH_BYTES (2)
+
+namespace Skill {
+
+// Each byte is coded as the difference to the same byte of the previous frame (the first frame
+// is coded against zeros). Differences wrap at 8 bits, so any data round trips exactly.
+// Differences are packed as 4 bit nibbles, high nibble first:
+//      a difference in [-7, 7] is a single nibble
+//      anything else is the escape nibble (0x8) followed by the difference as two nibbles
+// A trailing half byte is padded with a zero nibble.
+//
+// The decoder works in place on the output, so it can be fed the packed bytes in pieces as they
+// arrive without any buffering of its own.
+class DeltaDecoder {
+  public:
+    DeltaDecoder() = default;
+
+    void begin(char* out, uint16_t length, uint8_t frameSize);
+
+    // Returns the number of packed bytes used, which is less than len once the output is full.
+    uint16_t decode(const char* in, uint16_t len);
+
+    bool done() const { return _index >= _length; }
+    uint16_t decoded() const { return _index; }
+
+  protected:
+    void _nibble(uint8_t nibble);
+    void _put(uint8_t difference);
+
+    char* _out = nullptr;
+    uint16_t _length = 0;
+    uint16_t _index = 0;
+    uint8_t _frameSize = 0;
+    uint8_t _escaped = 0; // Nibbles of an escaped difference received so far, plus one
+    uint8_t _raw = 0;
+};
+
+// Returns the packed length, or 0 if it does not fit in capacity.
+// Pass a capacity below length to only accept an encoding which saves space.
+uint16_t deltaEncode(const char* spec, uint16_t length, uint8_t frameSize, char* out, uint16_t capacity);
+
+}
+
+#endif // _BITTLEET_SKILL_DELTA_H_
@@ -0,0 +1,90 @@
+//
+// Bittle Gait Stream
+// Streams gait frames from the I2C EEPROM through a small double buffered window
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "GaitStream.h"
+#include "I2cEeprom.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace Skill {
+
+void GaitStream::begin(uint16_t address, uint8_t frames) {
+    _address = address;
+    _frames = frames;
+    _count[0] = 0;
+    _count[1] = 0;
+    _current = 0;
+    _misses = 0;
+    if (_frames != 0) {
+        _fill(0, 0);
+    }
+}
+
+void GaitStream::resume(uint16_t address, uint8_t frames, const char* firstWindow) {
+    _address = address;
+    _frames = frames;
+    _count[1] = 0;
+    _current = 0;
+    _misses = 0;
+    _first[0] = 0;
+    _count[0] = _windowFrames(0);
+    memcpy(_window[0], firstWindow, (uint16_t)_count[0] * WALKING_DOF);
+}
+
+const char* GaitStream::frame(uint8_t index) {
+    if (index >= _frames) {
+        return NULL;
+    }
+    int8_t half = _holding(index);
+    if (half < 0) {
+        half = _current ^ 1;
+        _fill(half, index);
+        _misses++;
+    }
+    _current = half;
+    return &_window[half][(uint16_t)(index - _first[half]) * WALKING_DOF];
+}
+
+void GaitStream::prefetch() {
+    if (_frames == 0) {
+        return;
+    }
+    uint8_t next = _first[_current] + _count[_current];
+    if (next >= _frames) {
+        next = 0;
+    }
+    if (_holding(next) < 0) {
+        _fill(_current ^ 1, next);
+    }
+}
+
+int8_t GaitStream::_holding(uint8_t index) const {
+    for (uint8_t half = 0; half < 2; half++) {
+        if ((index >= _first[half]) && (index < _first[half] + _count[half])) {
+            return half;
+        }
+    }
+    return -1;
+}
+
+uint8_t GaitStream::_windowFrames(uint8_t firstFrame) const {
+    const uint8_t count = _frames - firstFrame;
+    return (count > GAIT_STREAM_WINDOW_FRAMES) ? GAIT_STREAM_WINDOW_FRAMES : count;
+}
+
+void GaitStream::_fill(uint8_t half, uint8_t firstFrame) {
+    const uint8_t count = _windowFrames(firstFrame);
+    const uint16_t address = _address + (uint16_t)firstFrame * WALKING_DOF;
+    I2cEeprom::read(address, _window[half], (uint16_t)count * WALKING_DOF);
+    _first[half] = firstFrame;
+    _count[half] = count;
+}
+
+} // namespace Skill
@@ -0,0 +1,56 @@
+//
+// Bittle Gait Stream
+// Streams gait frames from the I2C EEPROM through a small double buffered window
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_GAIT_STREAM_H_
+#define _BITTLEET_SKILL_GAIT_STREAM_H_
+
+#include <stdint.h>
+#include "../Bittle.h"
+
+#define GAIT_STREAM_WINDOW_FRAMES (1)
+#define GAIT_STREAM_WINDOW_BYTES (GAIT_STREAM_WINDOW_FRAMES * WALKING_DOF)
+
+namespace Skill {
+
+// While one half of the window is being played, prefetch() fills the other half with the frames which follow.
+// RAM use is fixed by GAIT_STREAM_WINDOW_FRAMES regardless of how long the gait is.
+class GaitStream {
+  public:
+    GaitStream() = default;
+
+    void begin(uint16_t address, uint8_t frames); // Blocks until the first window is loaded.
+    // As begin(), with the first window handed in from a copy saved earlier, so nothing is read.
+    void resume(uint16_t address, uint8_t frames, const char* firstWindow);
+    const char* frame(uint8_t index);
+    void prefetch();
+
+    uint8_t frames() const { return _frames; }
+    uint16_t address() const { return _address; }
+    uint16_t firstWindowBytes() const { return (uint16_t)_windowFrames(0) * WALKING_DOF; }
+    uint16_t misses() const { return _misses; }
+
+  protected:
+    int8_t _holding(uint8_t index) const;
+    uint8_t _windowFrames(uint8_t firstFrame) const;
+    void _fill(uint8_t half, uint8_t firstFrame);
+
+    uint16_t _address = 0;
+    uint8_t _frames = 0;
+
+    char _window[2][GAIT_STREAM_WINDOW_BYTES];
+    uint8_t _first[2] = {};
+    uint8_t _count[2] = {};
+    uint8_t _current = 0;
+
+    uint16_t _misses = 0;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_GAIT_STREAM_H_
@@ -0,0 +1,72 @@
+//
+// Bittle I2C EEPROM
+// Burst reads from the AT24C32 which holds the instinct skills
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "I2cEeprom.h"
+
+#include <Arduino.h>
+#include <Wire.h>
+
+namespace Skill {
+
+uint16_t I2cEeprom::_cursor = 0;
+bool I2cEeprom::_cursorValid = false;
+uint32_t I2cEeprom::_bytesRead = 0;
+uint16_t I2cEeprom::_addressWrites = 0;
+uint16_t I2cEeprom::_requests = 0;
+
+uint16_t I2cEeprom::read(uint16_t address, char* dest, uint16_t len) {
+    if (!_cursorValid || (_cursor != address % I2C_EEPROM_SIZE)) {
+        _setAddress(address);
+    }
+
+    uint16_t index = 0;
+    while (index < len) {
+        uint16_t burst = len - index;
+        if (burst > I2C_EEPROM_BURST) {
+            burst = I2C_EEPROM_BURST;
+        }
+        const uint16_t toEnd = I2C_EEPROM_SIZE - _cursor;
+        if (burst > toEnd) {
+            burst = toEnd; // The device wraps to 0 here, keep our cursor in step with it
+        }
+
+        _requests++;
+        const uint16_t received = Wire.requestFrom(I2C_EEPROM_ADDRESS, (int)burst);
+        uint16_t count = 0;
+        while (Wire.available() && (count < burst)) {
+            dest[index++] = Wire.read();
+            count++;
+        }
+        _bytesRead += count;
+        _cursor = (_cursor + count) % I2C_EEPROM_SIZE;
+        if ((received == 0) || (count < burst)) {
+            _cursorValid = false;
+            break;
+        }
+    }
+    return index;
+}
+
+void I2cEeprom::resetStats() {
+    _bytesRead = 0;
+    _addressWrites = 0;
+    _requests = 0;
+}
+
+void I2cEeprom::_setAddress(uint16_t address) {
+    Wire.beginTransmission(I2C_EEPROM_ADDRESS);
+    Wire.write((int)((address) >> 8));   // MSB
+    Wire.write((int)((address) & 0xFF)); // LSB
+    Wire.endTransmission();
+    _addressWrites++;
+    _cursor = address % I2C_EEPROM_SIZE; // The device ignores the unused high address bits
+    _cursorValid = true;
+}
+
+} // namespace Skill
@@ -0,0 +1,57 @@
+//
+// Bittle I2C EEPROM
+// Burst reads from the 64 kbit (AT24C64) EEPROM which holds the instinct skills
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_I2C_EEPROM_H_
+#define _BITTLEET_SKILL_I2C_EEPROM_H_
+
+#include <stdint.h>
+
+#define I2C_EEPROM_ADDRESS (0x54)
+#define I2C_EEPROM_SIZE (65536/8) // 64 kbit in bytes, the same as EEPROM_SIZE in OpenCat.h which writes the skills
+#define I2C_EEPROM_PAGE_SIZE (32)
+
+// Size of the AVR Wire receive buffer. Reads go straight from there into the caller's memory,
+// so a burst can be this large without costing any RAM of our own.
+#define I2C_EEPROM_BURST (32)
+
+namespace Skill {
+
+// There is one EEPROM on the bus, so its state is shared by every reader.
+//
+// The device keeps its own address counter which advances with every byte read. We track where it
+// points so that a read which follows on from the last one needs no address write at all.
+// Sequential reads run across the 32-byte write pages and only wrap at the end of the array,
+// so bursts are only split at I2C_EEPROM_BURST and at the end of the device.
+class I2cEeprom {
+  public:
+    // Returns the number of bytes actually read, which is less than len only if the device stops responding.
+    static uint16_t read(uint16_t address, char* dest, uint16_t len);
+
+    // Call after talking to the EEPROM without going through this class.
+    static void invalidate() { _cursorValid = false; }
+
+    static uint32_t bytesRead() { return _bytesRead; }
+    static uint16_t addressWrites() { return _addressWrites; }
+    static uint16_t requests() { return _requests; }
+    static void resetStats();
+
+  protected:
+    static void _setAddress(uint16_t address);
+
+    static uint16_t _cursor;
+    static bool _cursorValid;
+
+    static uint32_t _bytesRead;
+    static uint16_t _addressWrites;
+    static uint16_t _requests;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_I2C_EEPROM_H_
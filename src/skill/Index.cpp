@@ -0,0 +1,103 @@
+//
+// Bittle Skill Index
+// RAM resident lookup of skill name to I2C EEPROM address
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Index.h"
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+#define PTLF(s) Serial.println(F(s))
+
+namespace Skill {
+
+// Must match Index::hash
+static inline uint16_t hashStep(uint16_t hash, char c) {
+    return (hash << 5) + hash + (uint8_t)c;
+}
+
+void Index::build(int16_t tableAddress, uint8_t numSkills) {
+    _size = 0;
+    _tableAddress = tableAddress;
+    int16_t address = tableAddress;
+    for (uint8_t s = 0; s < numSkills; s++) {
+        uint8_t nameLen = EEPROM.read(address++);
+        uint16_t h = SKILL_HASH_SEED;
+        for (uint8_t l = 0; l < nameLen; l++) {
+            h = hashStep(h, (char)EEPROM.read(address++));
+        }
+        const char skillType = EEPROM.read(address++);
+        const uint8_t lowByte = EEPROM.read(address++);
+        const uint8_t highByte = EEPROM.read(address++);
+        if (skillType == 'I') {
+            _insert(h, ((uint16_t)highByte << 8) | lowByte, s);
+        }
+    }
+}
+
+int16_t Index::lookup(const char* name) const {
+    const uint16_t h = hash(name);
+    int16_t i = _find(h);
+    if (i < 0) {
+        return -1;
+    }
+    for (; (i < _size) && (_entries[i].hash == h); i++) {
+        if (_nameMatches(_entries[i].position, name)) {
+            return _entries[i].address;
+        }
+    }
+    return -1;
+}
+
+// First entry with the hash, since colliding names sit next to each other
+int16_t Index::_find(uint16_t h) const {
+    uint8_t low = 0;
+    uint8_t high = _size;
+    while (low < high) {
+        const uint8_t mid = (low + high) / 2;
+        if (_entries[mid].hash < h) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return ((low < _size) && (_entries[low].hash == h)) ? low : -1;
+}
+
+// Walks the table to the entry rather than keeping name addresses in RAM. The on-chip EEPROM is quick to read.
+bool Index::_nameMatches(uint8_t position, const char* name) const {
+    int16_t address = _tableAddress;
+    for (uint8_t s = 0; s < position; s++) {
+        address += EEPROM.read(address) + 4; // Length, name, type and two address bytes
+    }
+    const uint8_t nameLen = EEPROM.read(address++);
+    for (uint8_t l = 0; l < nameLen; l++) {
+        if (name[l] != (char)EEPROM.read(address++)) {
+            return false;
+        }
+    }
+    return name[nameLen] == '\0';
+}
+
+void Index::_insert(uint16_t hash, uint16_t address, uint8_t position) {
+    if (_size >= SKILL_INDEX_CAPACITY) {
+        return;
+    }
+    uint8_t i = _size;
+    while ((i > 0) && (_entries[i - 1].hash > hash)) {
+        _entries[i] = _entries[i - 1];
+        i--;
+    }
+    if ((i > 0) && (_entries[i - 1].hash == hash)) {
+        PTLF("skill hash collision!");
+    }
+    _entries[i] = Entry{hash, address, position};
+    _size++;
+}
+
+} // namespace Skill
@@ -0,0 +1,56 @@
+//
+// Bittle Skill Index
+// RAM resident lookup of skill name to I2C EEPROM address
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_INDEX_H_
+#define _BITTLEET_SKILL_INDEX_H_
+
+#include <stdint.h>
+
+#define SKILL_INDEX_CAPACITY (31)
+#define SKILL_HASH_SEED (5381)
+
+namespace Skill {
+
+// Built once from the on-chip EEPROM name table, which is laid out as:
+//      [nameLen] [name...] [type] [addressLow] [addressHigh]
+// Only instincts ('I') are indexed, since those are the skills we can load from the I2C EEPROM.
+// Entries are kept sorted by name hash so lookups are a binary search.
+// A hash match is checked against the name in the table, so an unknown name never borrows another skill's address.
+class Index {
+  public:
+    Index() = default;
+
+    void build(int16_t tableAddress, uint8_t numSkills);
+    int16_t lookup(const char* name) const;
+    uint8_t size() const { return _size; }
+
+    // djb2, truncated to 16 bits. Cheap on AVR (shift and add only) and collision free for the Bittle instincts.
+    static constexpr uint16_t hash(const char* name, uint16_t h = SKILL_HASH_SEED) {
+        return (*name == '\0') ? h : hash(name + 1, (uint16_t)((h << 5) + h + (uint8_t)*name));
+    }
+
+  protected:
+    struct Entry {
+        uint16_t hash;
+        uint16_t address;
+        uint8_t position; // Position in the name table, for the name check
+    };
+
+    int16_t _find(uint16_t hash) const;
+    bool _nameMatches(uint8_t position, const char* name) const;
+    void _insert(uint16_t hash, uint16_t address, uint8_t position);
+
+    Entry _entries[SKILL_INDEX_CAPACITY];
+    uint8_t _size = 0;
+    int16_t _tableAddress = 0;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_INDEX_H_
@@ -0,0 +1,172 @@
+//
+// Bittle Skill Cache
+// Loader decorator which keeps recently used skills in RAM
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "LoaderCached.h"
+#include "GaitStream.h"
+
+#include <string.h>
+
+namespace Skill {
+
+void LoaderCached::load(const Command::Command& command, Skill& skill) {
+    begin(command, skill);
+    while (!step()) {}
+}
+
+void LoaderCached::begin(const Command::Command& command, Skill& skill) {
+    _pendingSkill = NULL;
+    const Slot s = slot(command);
+    const int8_t index = _find(s);
+    if (index >= 0) {
+        _hits++;
+        _entries[index].lastUsed = ++_clock;
+        _handOut(index, skill);
+        _activeSkill = &skill;
+        _activeSlot = s;
+        _activeOutsideCache = false;
+        return;
+    }
+    if (s != SKILL_SLOT_NONE) {
+        _misses++;
+    }
+    _prefetchSlot = SKILL_SLOT_NONE; // The wrapped loader is restarted below
+    _pendingSkill = &skill;
+    _pendingSlot = s;
+    _activeSkill = NULL;
+    _activeSlot = SKILL_SLOT_NONE;
+    _activeOutsideCache = true;
+    _loader.begin(command, skill);
+}
+
+bool LoaderCached::step() {
+    if (_pendingSkill != NULL) {
+        if (!_loader.step()) {
+            return false;
+        }
+        const int8_t index = _insert(_pendingSlot, *_pendingSkill, SKILL_SLOT_NONE);
+        if (index >= 0) {
+            _handOut(index, *_pendingSkill); // Frees the wrapped loader for prefetching
+            _activeSkill = _pendingSkill;
+            _activeSlot = _pendingSlot;
+            _activeOutsideCache = false;
+        } else {
+            _activeOutsideCache = (_pendingSkill->spec != NULL) && !_pendingSkill->progmem;
+        }
+        _pendingSkill = NULL;
+        return true;
+    }
+    if (prefetching() && _loader.step()) {
+        if (_insert(_prefetchSlot, _prefetchSkill, _activeSlot) >= 0) {
+            _prefetches++;
+        }
+        _prefetchSlot = SKILL_SLOT_NONE;
+    }
+    return true;
+}
+
+bool LoaderCached::prefetch(const Command::Command& command) {
+    if ((_pendingSkill != NULL) || prefetching() || _activeOutsideCache) {
+        return false;
+    }
+    const Slot s = slot(command);
+    if ((s == SKILL_SLOT_NONE) || (_find(s) >= 0)) {
+        return false;
+    }
+    _prefetchSlot = s;
+    _loader.begin(command, _prefetchSkill);
+    return true;
+}
+
+int8_t LoaderCached::_find(Slot s) const {
+    if (s == SKILL_SLOT_NONE) {
+        return -1;
+    }
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_entries[i].slot == s) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Returns the index of the new entry, or -1 if the skill could not be cached.
+int8_t LoaderCached::_insert(Slot s, const Skill& skill, Slot keep) {
+    if ((s == SKILL_SLOT_NONE) || (skill.type == Type::Invalid) || skill.progmem) {
+        return -1;
+    }
+    const bool streamed = (skill.stream != NULL);
+    const char* data = streamed ? skill.stream->frame(0) : skill.spec;
+    const uint16_t length = streamed ? skill.stream->firstWindowBytes() : skill.specLength;
+    if ((data == NULL) || (length > SKILL_CACHE_BYTES)) {
+        return -1;
+    }
+
+    while ((_count >= SKILL_CACHE_ENTRIES) || (length > SKILL_CACHE_BYTES - _used)) {
+        int8_t oldest = -1;
+        for (uint8_t i = 0; i < _count; i++) {
+            if (_entries[i].slot == keep) {
+                continue;
+            }
+            if ((oldest < 0) || ((uint16_t)(_clock - _entries[i].lastUsed) > (uint16_t)(_clock - _entries[oldest].lastUsed))) {
+                oldest = i;
+            }
+        }
+        if (oldest < 0) {
+            return -1;
+        }
+        _evict(oldest);
+    }
+
+    const uint8_t index = _count++;
+    Entry& entry = _entries[index];
+    entry.slot = s;
+    entry.lastUsed = ++_clock;
+    entry.skill = skill;
+    entry.skill.spec = &_storage[_used];
+    entry.skill.specLength = length;
+    entry.streamAddress = streamed ? skill.stream->address() : 0;
+    memcpy(entry.skill.spec, data, length);
+    _used += length;
+    return index;
+}
+
+// A streamed gait's window goes back into the stream, rather than out with the skill.
+void LoaderCached::_handOut(uint8_t index, Skill& skill) {
+    const Entry& entry = _entries[index];
+    skill = entry.skill;
+    if (skill.stream != NULL) {
+        skill.stream->resume(entry.streamAddress, skill.frames, entry.skill.spec);
+        skill.spec = NULL;
+        skill.specLength = 0;
+    }
+}
+
+// Storage is kept compact, so data after the evicted entry moves down to fill the gap.
+// The skill handed out for the active slot is a copy, so its spec pointer has to follow the move too,
+// unless the caller has since pointed it somewhere else.
+void LoaderCached::_evict(uint8_t index) {
+    char* start = _entries[index].skill.spec;
+    const uint16_t length = _entries[index].skill.specLength;
+    const uint16_t tail = (uint16_t)(&_storage[_used] - (start + length));
+    memmove(start, start + length, tail);
+    _used -= length;
+
+    _entries[index] = _entries[--_count];
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_entries[i].skill.spec > start) {
+            _entries[i].skill.spec -= length;
+        }
+    }
+    if ((_activeSkill != NULL) && (_activeSlot != SKILL_SLOT_NONE) &&
+        (_activeSkill->spec > start) && (_activeSkill->spec < &_storage[SKILL_CACHE_BYTES])) {
+        _activeSkill->spec -= length;
+    }
+}
+
+} // namespace Skill
@@ -0,0 +1,87 @@
+//
+// Bittle Skill Cache
+// Loader decorator which keeps recently used skills in RAM
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_LOADER_CACHED_H_
+#define _BITTLEET_SKILL_LOADER_CACHED_H_
+
+#include "Skill.h"
+#include "Table.h"
+
+#define SKILL_CACHE_ENTRIES (4)
+#define SKILL_CACHE_BYTES (SKILL_CACHE_ENTRIES * DOF) // Any mix of postures and streamed gait windows
+
+namespace Skill {
+
+// Skills are cached by slot once the wrapped loader has finished loading them.
+// A hit hands back the cached skill without touching the wrapped loader.
+// Skills served from the cache are only valid until the next load through this loader.
+// Flash skills are passed straight through since their frames are not held in RAM.
+// The byte budget gives every entry room for a posture or a streamed gait's first window. Behaviours are
+// larger and always come from the wrapped loader.
+// Streamed gaits only keep their first window, which a hit hands back to the stream, so switching back to a
+// recent gait reads nothing over I2C.
+//
+// prefetch() loads a skill into the cache in the background using the same step() calls.
+// The skill currently in use is never evicted by a prefetch, and a prefetch is refused while that
+// skill's data is held by the wrapped loader. Do not prefetch skills the wrapped loader would stream.
+class LoaderCached : public Loader {
+  public:
+    explicit LoaderCached(Loader& loader) : _loader(loader) {};
+
+    void load(const Command::Command& command, Skill& skill);
+    void begin(const Command::Command& command, Skill& skill);
+    bool step();
+
+    bool prefetch(const Command::Command& command);
+    bool prefetching() const { return _prefetchSlot != SKILL_SLOT_NONE; }
+
+    uint16_t hits() const { return _hits; }
+    uint16_t misses() const { return _misses; }
+    uint16_t used() const { return _used; }
+    uint16_t prefetches() const { return _prefetches; }
+
+  protected:
+    struct Entry {
+        Slot slot;
+        uint16_t lastUsed;
+        Skill skill;
+        uint16_t streamAddress; // Streamed gaits only
+    };
+
+    int8_t _find(Slot s) const;
+    int8_t _insert(Slot s, const Skill& skill, Slot keep);
+    void _evict(uint8_t index);
+    void _handOut(uint8_t index, Skill& skill);
+
+    Loader& _loader;
+
+    char _storage[SKILL_CACHE_BYTES];
+    uint16_t _used = 0;
+    Entry _entries[SKILL_CACHE_ENTRIES];
+    uint8_t _count = 0;
+    uint16_t _clock = 0;
+
+    Skill* _pendingSkill = NULL;
+    Slot _pendingSlot = SKILL_SLOT_NONE;
+
+    Skill _prefetchSkill = Skill::Empty();
+    Slot _prefetchSlot = SKILL_SLOT_NONE;
+
+    Skill* _activeSkill = NULL;
+    Slot _activeSlot = SKILL_SLOT_NONE;
+    bool _activeOutsideCache = false;
+
+    uint16_t _hits = 0;
+    uint16_t _misses = 0;
+    uint16_t _prefetches = 0;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_LOADER_CACHED_H_
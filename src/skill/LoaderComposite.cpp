@@ -0,0 +1,41 @@
+//
+// Bittle Composite Skill Loader
+// Tries one loader and falls back to another
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "LoaderComposite.h"
+
+namespace Skill {
+
+void LoaderComposite::load(const Command::Command& command, Skill& skill) {
+    begin(command, skill);
+    while (!step()) {}
+}
+
+void LoaderComposite::begin(const Command::Command& command, Skill& skill) {
+    _primary.load(command, skill);
+    if (skill.type != Type::Invalid) {
+        _primaryLoads++;
+        _fallbackLoading = false;
+        return;
+    }
+    _fallback.begin(command, skill);
+    _fallbackLoading = true;
+}
+
+bool LoaderComposite::step() {
+    if (!_fallbackLoading) {
+        return true;
+    }
+    if (_fallback.step()) {
+        _fallbackLoading = false;
+        return true;
+    }
+    return false;
+}
+
+} // namespace Skill
@@ -0,0 +1,38 @@
+//
+// Bittle Composite Skill Loader
+// Tries one loader and falls back to another
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_LOADER_COMPOSITE_H_
+#define _BITTLEET_SKILL_LOADER_COMPOSITE_H_
+
+#include "Skill.h"
+
+namespace Skill {
+
+// The primary loader must complete within begin() (e.g. LoaderProgmem), since it is asked first
+// for every skill. Anything it does not have is loaded by the fallback.
+class LoaderComposite : public Loader {
+  public:
+    LoaderComposite(Loader& primary, Loader& fallback) : _primary(primary), _fallback(fallback) {};
+
+    void load(const Command::Command& command, Skill& skill);
+    void begin(const Command::Command& command, Skill& skill);
+    bool step();
+
+    uint16_t primaryLoads() const { return _primaryLoads; }
+
+  protected:
+    Loader& _primary;
+    Loader& _fallback;
+    bool _fallbackLoading = false;
+    uint16_t _primaryLoads = 0;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_LOADER_COMPOSITE_H_
@@ -1,60 +1,38 @@
 #include "LoaderEeprom.h"
+#include "I2cEeprom.h"
 #include "../Bittle.h"
 
 #include <Arduino.h>
-#include <Wire.h>
-#include <EEPROM.h>
+#include <string.h>
 
 #define PT(s) Serial.print(s)  //makes life easier
 #define PTL(s) Serial.println(s)
 #define PTF(s) Serial.print(F(s))//trade flash memory for dynamic memory with F() function
 #define PTLF(s) Serial.println(F(s))
 
-#define DEVICE_ADDRESS 0x54
-#define WIRE_BUFFER 8 // We use a small buffer to keep RAM usage low.
-
 #define NUM_SKILLS 31
 
 #define LOOKUP_NAME_START_ADDR 200  // On chip skills name start address.
 
 namespace Skill {
 
-//This function will read a 2 byte integer from the eeprom at the specified address and address + 1
-static int EEPROMReadInt(int p_address)
-{
-  byte lowByte = EEPROM.read(p_address);
-  byte highByte = EEPROM.read(p_address + 1);
-  return ((lowByte << 0) & 0xFF) + ((highByte << 8) & 0xFF00);
+LoaderEeprom::LoaderEeprom() {
+    // Only the slots are ever loaded, so once they are resolved the index is done with; it lives on the stack.
+    Index index;
+    index.build(LOOKUP_NAME_START_ADDR, NUM_SKILLS);
+    char name[SKILL_NAME_SIZE];
+    for (Slot s = 0; s < SKILL_SLOTS; s++) {
+        _addresses[s] = slotName(s, name) ? index.lookup(name) : -1;
+    }
 }
 
-  
 int16_t LoaderEeprom::_lookupAddressByName(const char* skillName) {
     PTL(skillName);
-    int skillAddressShift = 0;
-    int expectedLen = strlen(skillName);
-    for (byte s = 0; s < NUM_SKILLS; s++) {
-        byte nameLen = EEPROM.read(LOOKUP_NAME_START_ADDR + skillAddressShift++);
-        if (nameLen != expectedLen)
-        {
-            skillAddressShift += nameLen;
-        } else {
-            char* readName = new char[nameLen + 1];
-            for (byte l = 0; l < nameLen; l++) {
-                readName[l] = EEPROM.read(LOOKUP_NAME_START_ADDR + skillAddressShift++);
-            }
-            readName[nameLen] = '\0';
-            if (!strcmp(readName, skillName)) {
-                delete[]readName;
-                char skillType = EEPROM.read(LOOKUP_NAME_START_ADDR + skillAddressShift);
-                if (skillType != 'I') { 
-                    return -1; // Can't load!
-                }
-                return EEPROMReadInt(LOOKUP_NAME_START_ADDR + skillAddressShift + 1);
-            }
-            delete[]readName;
+    char name[SKILL_NAME_SIZE];
+    for (Slot s = 0; s < SKILL_SLOTS; s++) {
+        if (slotName(s, name) && (strcmp(name, skillName) == 0) && (_addresses[s] != -1)) {
+            return _addresses[s];
         }
-        
-        skillAddressShift += 3;//1 byte type, 1 int address
     }
     PTLF("wrong key!");
     return -1;
@@ -64,148 +42,219 @@ int16_t LoaderEeprom::_lookupAddressByName(const char* skillName) {
 #define EXTENDED_HEADER (3)
 #define BEHAVIOR_SUFFIX (4)
 
+#define UNLIMITED_BYTES (0xFFFF)
+
+uint8_t LoaderEeprom::checkImage() {
+    uint8_t dropped = 0;
+    for (Slot s = 0; s < SKILL_SLOTS; s++) {
+        if (_addresses[s] == -1) {
+            continue;
+        }
+        char header[BASE_HEADER];
+        I2cEeprom::read(_addresses[s], header, BASE_HEADER);
+        const int8_t frameSpec = header[0];
+        const bool fits = (frameSpec == 1) ||
+                          ((frameSpec > 1) && (frameSpec <= MAX_GAIT_FRAMES)) ||
+                          ((frameSpec < 0) && (-frameSpec <= MAX_BEHAVIOUR_FRAMES));
+        if (!fits) {
+            PTLF("Skill too large for the arena");
+            _addresses[s] = -1;
+            dropped++;
+        }
+    }
+    return dropped;
+}
+
+void LoaderEeprom::load(const Command::Command& command, Skill& skill) {
+    begin(command, skill);
+    _step(UNLIMITED_BYTES);
+}
+
+void LoaderEeprom::begin(const Command::Command& command, Skill& skill) {
+    const Slot s = slot(command);
+    if ((s == SKILL_SLOT_NONE) || (_addresses[s] == -1)) {
+        _state = State::Idle;
+        return;  // TODO: Load default skill
+    }
+    _begin(_addresses[s], skill);
+}
+
+bool LoaderEeprom::step() {
+    return _step(LOADER_STEP_BYTES);
+}
+
 void LoaderEeprom::_loadFromAddress(uint16_t address, Skill& skill) {
+    _begin(address, skill);
+    _step(UNLIMITED_BYTES);
+}
+
+void LoaderEeprom::_begin(uint16_t address, Skill& skill) {
     skill.clear();
+    _skill = &skill;
+    _type = Type::Invalid;
+    _cursor = address;
+    _specIndex = 0;
+    _state = State::Header;
+}
+
+bool LoaderEeprom::_step(uint16_t budget) {
+    while (_state != State::Idle) {
+        const uint16_t cost = _stateCost(budget);
+        if (cost == 0) {
+            // With budget left, this is a Packed or Spec state with nothing to read, which would never finish
+            if (budget != 0) {
+                PTLF("Corrupt skill data");
+                _fail();
+            }
+            break;
+        }
+        if (cost > budget) {
+            break;
+        }
+        budget -= cost;
+        switch (_state) {
+            case State::Header:     _readHeader(); break;
+            case State::Extended:   _readExtendedHeader(); break;
+            case State::Spec:       _readSpec(cost); break;
+            case State::Length:     _readPackedLength(); break;
+            case State::Packed:     _readPacked(cost); break;
+            case State::Stream: {
+                _gaitStream->begin(_cursor, _skill->frames);
+                _skill->stream = _gaitStream;
+                _finish();
+                break;
+            }
+            default: break;
+        }
+    }
+    return (_state == State::Idle);
+}
+
+uint16_t LoaderEeprom::_stateCost(uint16_t budget) const {
+    switch (_state) {
+        case State::Header:     return BASE_HEADER;
+        case State::Extended:   return EXTENDED_HEADER;
+        case State::Stream:     return GAIT_STREAM_WINDOW_BYTES;
+        case State::Length:     return SKILL_DELTA_LENGTH_BYTES;
+        case State::Spec: {
+            const uint16_t remaining = _skill->specLength - _specIndex;
+            return (remaining < budget) ? remaining : budget;
+        }
+        case State::Packed:     return (_packedRemaining < budget) ? _packedRemaining : budget;
+        default:                return 0;
+    }
+}
 
-    Wire.beginTransmission(DEVICE_ADDRESS);
-    Wire.write((int)((address) >> 8));   // MSB
-    Wire.write((int)((address) & 0xFF)); // LSB
-    Wire.endTransmission();
-    Wire.requestFrom((int)DEVICE_ADDRESS, BASE_HEADER);
-    
-    int8_t frameSpec = Wire.read();
+void LoaderEeprom::_read(char* dest, uint16_t len) {
+    _cursor += I2cEeprom::read(_cursor, dest, len);
+}
+
+void LoaderEeprom::_readHeader() {
+    char header[BASE_HEADER];
+    _read(header, BASE_HEADER);
+
+    Skill& skill = *_skill;
+    const int8_t frameSpec = header[0];
     int16_t frameSize = DOF;
     if (frameSpec == 1) {
-        skill.type = Type::Posture;
+        _type = Type::Posture;
         skill.frames = 1;
         frameSize = DOF;
     } else if (frameSpec > 1) {
-        skill.type = Type::Gait;
+        _type = Type::Gait;
         skill.frames = frameSpec;
         frameSize = WALKING_DOF;
     } else if (frameSpec < 0) {
-        skill.type = Type::Behaviour;
+        _type = Type::Behaviour;
         skill.frames = -frameSpec;
         frameSize = DOF + BEHAVIOR_SUFFIX;
     } else {
         PTLF("Invalid skill spec");
+        _fail();
         return;
     }
 
-    skill.nominalRoll = (int8_t)Wire.read();
-    skill.nominalPitch = (int8_t)Wire.read();
-    skill.doubleAngles = (Wire.read() == 2) ? true : false;
+    skill.nominalRoll = (int8_t)header[1];
+    skill.nominalPitch = (int8_t)header[2];
+    const uint8_t angleRatio = (uint8_t)header[3];
+    skill.doubleAngles = ((angleRatio & ~SKILL_DELTA_FLAG) == 2) ? true : false;
+    _compressed = (angleRatio & SKILL_DELTA_FLAG) != 0;
 
-    if (skill.type == Type::Behaviour) {
-        Wire.requestFrom(DEVICE_ADDRESS, EXTENDED_HEADER);
-        skill.loopSpec.firstRow = Wire.read();
-        skill.loopSpec.finalRow = Wire.read();
-        skill.loopSpec.count = Wire.read();
+    // Streaming relies on reading any frame directly, which delta coded frames do not allow.
+    if ((_type == Type::Gait) && (_gaitStream != NULL) && !_compressed) {
+        _state = State::Stream;
+        return;
     }
 
-    skill.specLength = (uint16_t)skill.frames * frameSize;
-    skill.spec = new char[skill.specLength];
-
-    int index = 0;
-    int len = skill.specLength;
-    while (len > 0) {
-        Wire.requestFrom(DEVICE_ADDRESS, min(WIRE_BUFFER, len));
-        while (Wire.available() && (len > 0)) {
-            skill.spec[index++] = Wire.read();
-            len--;
-        }
+    const uint16_t specLength = (uint16_t)skill.frames * frameSize;
+    _arena.reset();
+    skill.spec = _arena.allocate(specLength);
+    if (skill.spec == NULL) {
+        PTLF("Skill too large");
+        _fail();
+        return;
+    }
+    skill.specLength = specLength;
+    if (_compressed) {
+        _decoder.begin(skill.spec, specLength, frameSize);
     }
+
+    _state = (_type == Type::Behaviour) ? State::Extended : _specState();
 }
 
+LoaderEeprom::State LoaderEeprom::_specState() const {
+    return _compressed ? State::Length : State::Spec;
+}
 
+void LoaderEeprom::_readExtendedHeader() {
+    char header[EXTENDED_HEADER];
+    _read(header, EXTENDED_HEADER);
+    _skill->loopSpec.firstRow = header[0];
+    _skill->loopSpec.finalRow = header[1];
+    _skill->loopSpec.count = header[2];
+    _state = _specState();
+}
 
-void LoaderEeprom::load(const Command::Command& command, Skill& skill) {
-    int address = -1;
-    switch (command.type()) {
-        case (Command::Type::Move): {
-            Command::Move cmd;
-            if (command.get(cmd)) {
-                if (cmd.direction == Command::Direction::Forward) {
-                    if (cmd.pace == Command::Pace::Slow) {
-                        address = _lookupAddressByName("crF");
-                    } else if (cmd.pace == Command::Pace::Medium) {
-                        address = _lookupAddressByName("wkF");
-                    } else if (cmd.pace == Command::Pace::Fast) {
-                        address = _lookupAddressByName("trF");
-                    }else if (cmd.pace == Command::Pace::Reverse) {
-                        address = _lookupAddressByName("bk");
-                    }
-                } else if (cmd.direction == Command::Direction::Left) {
-                    if (cmd.pace == Command::Pace::Slow) {
-                        address = _lookupAddressByName("crL");
-                    } else if (cmd.pace == Command::Pace::Medium) {
-                        address = _lookupAddressByName("wkL");
-                    } else if (cmd.pace == Command::Pace::Fast) {
-                        address = _lookupAddressByName("trL");
-                    }else if (cmd.pace == Command::Pace::Reverse) {
-                        address = _lookupAddressByName("bkL");
-                    }
-                } else if (cmd.direction == Command::Direction::Right) {
-                    if (cmd.pace == Command::Pace::Slow) {
-                        address = _lookupAddressByName("crR");
-                    } else if (cmd.pace == Command::Pace::Medium) {
-                        address = _lookupAddressByName("wkR");
-                    } else if (cmd.pace == Command::Pace::Fast) {
-                        address = _lookupAddressByName("trR");
-                    } else if (cmd.pace == Command::Pace::Reverse) {
-                        address = _lookupAddressByName("bkR");
-                    }
-                }
-            }
-            break;
-        }
-        case (Command::Type::Simple): {
-            Command::Simple cmd;
-            if (command.get(cmd)) {
-            switch (cmd) {
-                case (Command::Simple::Rest):                     address = _lookupAddressByName("rest"); break;
-                case (Command::Simple::Balance):                  address = _lookupAddressByName("balance"); break;
-                case (Command::Simple::Step):                     address = _lookupAddressByName("vt"); break;
-                case (Command::Simple::Sit):                      address = _lookupAddressByName("sit"); break;
-                case (Command::Simple::Stretch):                  address = _lookupAddressByName("str"); break;
-                case (Command::Simple::Greet):                    address = _lookupAddressByName("hi"); break;
-                case (Command::Simple::Pushup):                   address = _lookupAddressByName("pu"); break;
-                case (Command::Simple::Hydrant):                  address = _lookupAddressByName("pee"); break;
-                case (Command::Simple::Check):                    address = _lookupAddressByName("ck"); break;
-                case (Command::Simple::Dead):                     address = _lookupAddressByName("pd"); break;
-                case (Command::Simple::Zero):                     address = _lookupAddressByName("zero"); break;
-                case (Command::Simple::Lifted):                   address = _lookupAddressByName("lifted"); break;
-                case (Command::Simple::Dropped):                  address = _lookupAddressByName("dropped"); break;
-                case (Command::Simple::Recover):                  address = _lookupAddressByName("rc"); break;
-                case (Command::Simple::GyroToggle):               
-                case (Command::Simple::SaveServoCalibration):
-                case (Command::Simple::AbortServoCalibration):
-                case (Command::Simple::ShowJointAngles):
-                case (Command::Simple::Pause):
-                default:
-                break;
-            }
-            }
-            break;
-        }
-        case (Command::Type::WithArgs): {
-            Command::WithArgs cmd;
-            if (command.get(cmd)) {
-                if (cmd.cmd == Command::ArgType::Calibrate) {
-                    address = _lookupAddressByName("calib");
-                    break;
-                }
-            }
-            break;
-        }
-        case (Command::Type::None): {
-            return; // TODO: Load default skill
-        }
+void LoaderEeprom::_readPackedLength() {
+    char length[SKILL_DELTA_LENGTH_BYTES];
+    _read(length, SKILL_DELTA_LENGTH_BYTES);
+    _packedRemaining = (uint8_t)length[0] | ((uint16_t)(uint8_t)length[1] << 8);
+    _state = State::Packed;
+}
+
+void LoaderEeprom::_readPacked(uint16_t len) {
+    char packed[LOADER_STEP_BYTES];
+    while (len > 0) {
+        const uint16_t chunk = (len < LOADER_STEP_BYTES) ? len : LOADER_STEP_BYTES;
+        _read(packed, chunk);
+        _decoder.decode(packed, chunk);
+        _packedRemaining -= chunk;
+        len -= chunk;
     }
-    if (address == -1) {
-        return;  // TODO: Load default skill
+    if (_decoder.done()) {
+        _finish();
+    } else if (_packedRemaining == 0) {
+        PTLF("Corrupt skill data");
+        _fail();
+    }
+}
+
+void LoaderEeprom::_readSpec(uint16_t len) {
+    _read(_skill->spec + _specIndex, len);
+    _specIndex += len;
+    if (_specIndex >= _skill->specLength) {
+        _finish();
     }
-    _loadFromAddress(address, skill);
+}
+
+void LoaderEeprom::_finish() {
+    _skill->type = _type; // Only valid once everything has arrived
+    _state = State::Idle;
+}
+
+void LoaderEeprom::_fail() {
+    _skill->clear();
+    _state = State::Idle;
 }
 
 } // namespace Skill
\ No newline at end of file
@@ -1,20 +1,89 @@
 #ifndef _BITTLEET_SKILL_LOADER_EEPROM_H_
 #define _BITTLEET_SKILL_LOADER_EEPROM_H_
 
+#include "../Bittle.h"
 #include "Skill.h"
+#include "Arena.h"
+#include "Delta.h"
+#include "GaitStream.h"
+#include "I2cEeprom.h"
+#include "Index.h"
+#include "Table.h"
 
 
+// The skill being played has to be held in RAM, so this is the most the old per load heap block
+// could reach, now reserved up front where it cannot fragment. It is not new RAM on top of the heap peak.
+// Streaming does not shrink it: delta coded gaits are decoded whole, so the largest one still lands here,
+// and the largest behaviour needs only 16 bytes less. checkImage() confirms the skills on the robot fit.
+#define SKILL_ARENA_SIZE (MAX_GAIT_FRAMES * WALKING_DOF)
+
+// Most bytes moved over I2C by a single call to step(), one burst.
+#define LOADER_STEP_BYTES (I2C_EEPROM_BURST)
+
+static_assert(SKILL_ARENA_SIZE >= DOF, "Skill arena cannot hold a posture");
+static_assert(SKILL_ARENA_SIZE >= MAX_BEHAVIOUR_FRAMES * (DOF + 4), "Skill arena cannot hold the largest behaviour");
+static_assert(LOADER_STEP_BYTES >= GAIT_STREAM_WINDOW_BYTES, "Loader step cannot start a gait stream");
+
 namespace Skill {
 
+// Skills loaded by this loader share its arena - loading a skill invalidates the previously loaded skill data.
 class LoaderEeprom : public Loader {
   public:
-    LoaderEeprom() {};
+    LoaderEeprom();
 
     void load(const Command::Command& command, Skill& skill); 
+    void begin(const Command::Command& command, Skill& skill);
+    bool step();
+
+    uint16_t arenaHighWatermark() const { return _arena.highWatermark(); }
+
+    // Reads the header of every skill the slots resolve to, and drops those too large for the arena.
+    // Returns how many were dropped. Needs I2C, so call it after Wire.begin().
+    uint8_t checkImage();
+
+    // When set, gaits are played through the stream instead of being loaded into the arena.
+    void streamGaits(GaitStream* stream) { _gaitStream = stream; }
     
   protected:
+    enum class State : uint8_t {
+        Idle,
+        Header,
+        Extended,
+        Stream,
+        Spec,
+        Length,
+        Packed,
+    };
+
     void _loadFromAddress(uint16_t address, Skill& skill);
     int16_t _lookupAddressByName(const char* name);
+
+    void _begin(uint16_t address, Skill& skill);
+    bool _step(uint16_t budget);
+    uint16_t _stateCost(uint16_t budget) const;
+
+    void _read(char* dest, uint16_t len);
+    void _readHeader();
+    void _readExtendedHeader();
+    void _readSpec(uint16_t len);
+    void _readPackedLength();
+    void _readPacked(uint16_t len);
+    State _specState() const;
+    void _finish();
+    void _fail();
+
+    State _state = State::Idle;
+    Skill* _skill = NULL;
+    Type _type = Type::Invalid;
+    uint16_t _cursor = 0;
+    uint16_t _specIndex = 0;
+    bool _compressed = false;
+    uint16_t _packedRemaining = 0;
+    DeltaDecoder _decoder;
+
+    Arena<SKILL_ARENA_SIZE> _arena;
+    GaitStream* _gaitStream = NULL;
+    int16_t _addresses[SKILL_SLOTS]; // Resolved once at startup, -1 if the slot has no instinct.
 };
 
 }
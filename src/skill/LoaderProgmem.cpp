@@ -0,0 +1,72 @@
+//
+// Bittle Progmem Skill Loader
+// Serves skills straight out of flash
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "LoaderProgmem.h"
+#include "Delta.h"
+
+#include <Arduino.h>
+
+#define BASE_HEADER (4)
+#define EXTENDED_HEADER (3)
+#define BEHAVIOR_SUFFIX (4)
+
+namespace Skill {
+
+void LoaderProgmem::load(const Command::Command& command, Skill& skill) {
+    skill.clear();
+    const Slot s = slot(command);
+    if (s == SKILL_SLOT_NONE) {
+        return;
+    }
+    for (uint8_t i = 0; i < _size; i++) {
+        if (pgm_read_byte(&_table[i].slot) == s) {
+            _loadFromProgmem((const char*)pgm_read_ptr(&_table[i].data), skill);
+            return;
+        }
+    }
+}
+
+void LoaderProgmem::_loadFromProgmem(const char* data, Skill& skill) {
+    const int8_t frameSpec = (int8_t)pgm_read_byte(data);
+    const uint8_t angleRatio = pgm_read_byte(data + 3);
+    if ((frameSpec == 0) || (angleRatio & SKILL_DELTA_FLAG)) {
+        return;
+    }
+
+    Type type;
+    uint8_t frameSize;
+    uint8_t header = BASE_HEADER;
+    if (frameSpec == 1) {
+        type = Type::Posture;
+        skill.frames = 1;
+        frameSize = DOF;
+    } else if (frameSpec > 1) {
+        type = Type::Gait;
+        skill.frames = frameSpec;
+        frameSize = WALKING_DOF;
+    } else {
+        type = Type::Behaviour;
+        skill.frames = -frameSpec;
+        frameSize = DOF + BEHAVIOR_SUFFIX;
+        skill.loopSpec.firstRow = pgm_read_byte(data + BASE_HEADER);
+        skill.loopSpec.finalRow = pgm_read_byte(data + BASE_HEADER + 1);
+        skill.loopSpec.count = pgm_read_byte(data + BASE_HEADER + 2);
+        header += EXTENDED_HEADER;
+    }
+
+    skill.nominalRoll = (int8_t)pgm_read_byte(data + 1);
+    skill.nominalPitch = (int8_t)pgm_read_byte(data + 2);
+    skill.doubleAngles = (angleRatio == 2);
+    skill.spec = (char*)data + header;
+    skill.specLength = (uint16_t)skill.frames * frameSize;
+    skill.progmem = true;
+    skill.type = type;
+}
+
+} // namespace Skill
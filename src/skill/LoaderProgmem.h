@@ -0,0 +1,43 @@
+//
+// Bittle Progmem Skill Loader
+// Serves skills straight out of flash
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_LOADER_PROGMEM_H_
+#define _BITTLEET_SKILL_LOADER_PROGMEM_H_
+
+#include "Skill.h"
+#include "Table.h"
+
+namespace Skill {
+
+// Each skill is stored in flash in the same layout as the instinct image:
+//      [frameSpec] [roll] [pitch] [angleRatio] ([firstRow] [finalRow] [count]) [frames...]
+struct ProgmemSkill {
+    Slot slot;
+    const char* data;
+};
+
+// Nothing is copied - loaded skills point into flash, so they must be read with Skill::angle() or
+// Skill::copyFrame(). Delta coded skills cannot be read in place, so they are not supported.
+class LoaderProgmem : public Loader {
+  public:
+    // The table itself lives in flash too.
+    LoaderProgmem(const ProgmemSkill* table, uint8_t size) : _table(table), _size(size) {};
+
+    void load(const Command::Command& command, Skill& skill);
+
+  protected:
+    void _loadFromProgmem(const char* data, Skill& skill);
+
+    const ProgmemSkill* _table;
+    uint8_t _size;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_LOADER_PROGMEM_H_
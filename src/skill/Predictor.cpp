@@ -0,0 +1,47 @@
+//
+// Bittle Skill Predictor
+// Learns which skill usually follows another so it can be loaded ahead of time
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Predictor.h"
+
+namespace Skill {
+
+Predictor::Predictor() {
+    for (uint8_t i = 0; i < SKILL_SLOTS; i++) {
+        _votes[i] = 0; // No confidence, so the candidate is never used
+    }
+}
+
+void Predictor::observe(Slot s) {
+    if (s >= SKILL_SLOTS) {
+        return;
+    }
+    if (_last != SKILL_SLOT_NONE) {
+        const uint8_t vote = _votes[_last];
+        const uint8_t confidence = _confidenceOf(vote);
+        if (confidence == 0) {
+            _votes[_last] = _vote(s, 1);
+        } else if (_nextOf(vote) == s) {
+            if (confidence < PREDICTOR_MAX_CONFIDENCE) {
+                _votes[_last] = vote + 1;
+            }
+        } else {
+            _votes[_last] = vote - 1;
+        }
+    }
+    _last = s;
+}
+
+Slot Predictor::predict() const {
+    if ((_last == SKILL_SLOT_NONE) || (_confidenceOf(_votes[_last]) == 0)) {
+        return SKILL_SLOT_NONE;
+    }
+    return _nextOf(_votes[_last]);
+}
+
+} // namespace Skill
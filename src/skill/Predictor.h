@@ -0,0 +1,49 @@
+//
+// Bittle Skill Predictor
+// Learns which skill usually follows another so it can be loaded ahead of time
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_PREDICTOR_H_
+#define _BITTLEET_SKILL_PREDICTOR_H_
+
+#include <stdint.h>
+#include "Table.h"
+
+#define PREDICTOR_MAX_CONFIDENCE (3)
+#define PREDICTOR_CONFIDENCE_BITS (2)
+
+static_assert(PREDICTOR_MAX_CONFIDENCE < (1 << PREDICTOR_CONFIDENCE_BITS), "Predictor confidence does not fit its bits");
+static_assert(SKILL_SLOTS <= (1 << (8 - PREDICTOR_CONFIDENCE_BITS)), "Predictor slots do not fit their bits");
+
+namespace Skill {
+
+// A full first-order transition table would be SKILL_SLOTS^2 counters, far too much RAM for the AVR.
+// Instead each slot keeps a single majority vote candidate for its successor with a small
+// saturating confidence, which tracks the most common transition. Both are packed into one byte per slot.
+class Predictor {
+  public:
+    Predictor();
+
+    // Record that a skill slot was started. SKILL_SLOT_NONE is ignored.
+    void observe(Slot s);
+
+    // Most likely slot to follow the last observed slot, or SKILL_SLOT_NONE if nothing was learned.
+    Slot predict() const;
+    Slot last() const { return _last; }
+
+  protected:
+    static Slot _nextOf(uint8_t vote) { return vote >> PREDICTOR_CONFIDENCE_BITS; }
+    static uint8_t _confidenceOf(uint8_t vote) { return vote & ((1 << PREDICTOR_CONFIDENCE_BITS) - 1); }
+    static uint8_t _vote(Slot next, uint8_t confidence) { return (uint8_t)(next << PREDICTOR_CONFIDENCE_BITS) | confidence; }
+
+    uint8_t _votes[SKILL_SLOTS]; // Candidate successor, then its confidence in the low bits
+    Slot _last = SKILL_SLOT_NONE;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_PREDICTOR_H_
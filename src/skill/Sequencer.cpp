@@ -0,0 +1,76 @@
+//
+// Bittle Skill Sequencer
+// Plays a list of skills back to back
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Sequencer.h"
+
+namespace Skill {
+
+void Sequencer::clear() {
+    _size = 0;
+    _index = 0;
+    _elapsed = 0;
+    _active = false;
+}
+
+bool Sequencer::add(Slot slot, uint16_t ticks, uint8_t cycles) {
+    // Only skills which can be played; a step without a skill would never finish.
+    if ((_size >= SEQUENCE_CAPACITY) || (slot >= SKILL_SLOT_CALIBRATE) || (slotHash(slot) == SKILL_NO_HASH)) {
+        return false;
+    }
+    if ((ticks == 0) && (cycles == 0)) {
+        cycles = 1;
+    }
+    _steps[_size++] = Step{slot, ticks, cycles};
+    return true;
+}
+
+bool Sequencer::start() {
+    _index = 0;
+    _elapsed = 0;
+    _active = (_size > 0);
+    return _active;
+}
+
+Sequencer::Action Sequencer::tick(bool cycleComplete) {
+    if (!_active) {
+        return Action::None;
+    }
+    const Step& step = _steps[_index];
+    if (step.ticks != 0) {
+        _elapsed++;
+        if (_elapsed < step.ticks) {
+            return Action::None;
+        }
+    } else {
+        if (cycleComplete) {
+            _elapsed++;
+        }
+        if (_elapsed < step.cycles) {
+            return Action::None;
+        }
+    }
+
+    _elapsed = 0;
+    _index++;
+    if (_index >= _size) {
+        _active = false;
+        return Action::Done;
+    }
+    return Action::Start;
+}
+
+Command::Command Sequencer::current() const {
+    return (_index < _size) ? slotCommand(_steps[_index].slot) : Command::Command();
+}
+
+Command::Command Sequencer::next() const {
+    return (_index + 1 < _size) ? slotCommand(_steps[_index + 1].slot) : Command::Command();
+}
+
+} // namespace Skill
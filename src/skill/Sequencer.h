@@ -0,0 +1,68 @@
+//
+// Bittle Skill Sequencer
+// Plays a list of skills back to back
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_SEQUENCER_H_
+#define _BITTLEET_SKILL_SEQUENCER_H_
+
+#include <stdint.h>
+#include "../command/Command.h"
+#include "Table.h"
+
+#define SEQUENCE_CAPACITY (COMMAND_MAX_ARGS / 2)
+
+namespace Skill {
+
+// Each step plays a skill for a number of motion ticks, or for a number of cycles of the skill.
+// Steps are held as slots rather than commands to keep the list small.
+//
+// The sequencer only keeps count; the motion task reports each tick and starts the skill it is told to.
+// next() is known as soon as a step starts, so the following skill can be loaded while this one plays.
+class Sequencer {
+  public:
+    enum class Action : uint8_t {
+        None,
+        Start, // Start current() on this tick
+        Done,
+    };
+
+    Sequencer() = default;
+
+    void clear();
+    // A step with neither ticks nor cycles plays a single cycle. Returns false when full or the slot has no skill.
+    bool add(Slot slot, uint16_t ticks, uint8_t cycles = 0);
+
+    bool start(); // Returns false for an empty sequence. Start current() straight away.
+    void stop() { _active = false; }
+
+    // Call once per motion tick while the skill is playing. cycleComplete is set on the tick a cycle finishes.
+    Action tick(bool cycleComplete);
+
+    bool active() const { return _active; }
+    uint8_t size() const { return _size; }
+    uint8_t index() const { return _index; }
+    Command::Command current() const;
+    Command::Command next() const; // Empty on the last step
+
+  protected:
+    struct Step {
+        Slot slot;
+        uint16_t ticks;
+        uint8_t cycles;
+    };
+
+    Step _steps[SEQUENCE_CAPACITY];
+    uint8_t _size = 0;
+    uint8_t _index = 0;
+    uint16_t _elapsed = 0; // Ticks or cycles, depending on the step
+    bool _active = false;
+};
+
+}
+
+#endif // _BITTLEET_SKILL_SEQUENCER_H_
@@ -9,6 +9,11 @@
 
 
 #include "Skill.h"
+#include "GaitStream.h"
+
+#include <Arduino.h>
+
+#define BEHAVIOUR_SUFFIX (4)
 
 namespace Skill {
 
@@ -21,11 +26,51 @@ void Skill::clear(){
     loopSpec.firstRow = 0;
     loopSpec.finalRow = 0;
     loopSpec.count = 0;
-    if (spec != NULL){
-        delete[] spec;
-        spec = NULL;
-    }
+    spec = NULL; // Owned by the loader
     specLength = 0; 
+    stream = NULL;
+    progmem = false;
+}
+
+uint8_t Skill::frameSize() const {
+    switch (type) {
+        case Type::Posture:     return DOF;
+        case Type::Gait:        return WALKING_DOF;
+        case Type::Behaviour:   return DOF + BEHAVIOUR_SUFFIX;
+        default:                return 0;
+    }
+}
+
+const char* Skill::frame(uint8_t index) const {
+    if (stream != NULL) {
+        return stream->frame(index);
+    }
+    if ((spec == NULL) || progmem || (index >= frames)) {
+        return NULL;
+    }
+    return spec + (uint16_t)index * frameSize();
+}
+
+int8_t Skill::angle(uint8_t frame, uint8_t index) const {
+    if ((frame >= frames) || (index >= frameSize())) {
+        return 0;
+    }
+    if (stream != NULL) {
+        const char* streamed = stream->frame(frame);
+        return (streamed == NULL) ? 0 : streamed[index];
+    }
+    if (spec == NULL) {
+        return 0;
+    }
+    const char* value = spec + (uint16_t)frame * frameSize() + index;
+    return progmem ? (int8_t)pgm_read_byte(value) : *value;
+}
+
+void Skill::copyFrame(uint8_t frame, char* dest) const {
+    const uint8_t size = frameSize();
+    for (uint8_t i = 0; i < size; i++) {
+        dest[i] = angle(frame, i);
+    }
 }
 
 Skill Skill::Empty() {
@@ -42,6 +87,8 @@ Skill Skill::Empty() {
         },
         .spec = NULL,
         .specLength = 0, 
+        .stream = NULL,
+        .progmem = false,
     };
 }
 
@@ -30,6 +30,8 @@ struct LoopSpec {
     uint8_t count;
 };
 
+class GaitStream;
+
 struct Skill {
     Type type;
     uint8_t frames;
@@ -37,8 +39,17 @@ struct Skill {
     int8_t nominalPitch;
     bool doubleAngles;
     LoopSpec loopSpec;
-    char * spec; // Interpretation depends on type
+    char * spec; // Interpretation depends on type. Owned by the loader which loaded the skill.
     uint16_t specLength;
+    GaitStream* stream; // Set when gait frames are streamed rather than held in spec.
+    bool progmem; // Set when spec points into flash, which frame() cannot hand out.
+
+    uint8_t frameSize() const;
+    const char* frame(uint8_t index) const; // RAM skills only, NULL otherwise.
+
+    // These work wherever the frames are held. Angles outside the skill, or of a skill with no data, read as 0.
+    int8_t angle(uint8_t frame, uint8_t index) const;
+    void copyFrame(uint8_t frame, char* dest) const;
 
     void clear();
 
@@ -48,6 +59,12 @@ struct Skill {
 class Loader {
   public:
     virtual void load(const Command::Command& command, Skill& skill) = 0;
+
+    // Asynchronous loading - begin() then call step() each tick until it returns true.
+    // The skill must not be used until loading completes.
+    // Loaders which cannot split up their work complete the load within begin().
+    virtual void begin(const Command::Command& command, Skill& skill) { load(command, skill); }
+    virtual bool step() { return true; }
 };
 
 }
@@ -0,0 +1,144 @@
+//
+// Bittle Skill Table
+// Maps commands directly to skill slots
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Table.h"
+#include "Index.h"
+
+#include <Arduino.h>
+
+namespace Skill {
+
+// Instinct names in slot order, each ending in a terminator. An empty name is a slot with no skill.
+// Kept in flash, and only copied out when a slot is resolved.
+static constexpr char SLOT_NAMES[] PROGMEM =
+    // Moves - Forward, Left,   Right
+    "crF\0"         "crL\0"  "crR\0"   // Slow
+    "wkF\0"         "wkL\0"  "wkR\0"   // Medium
+    "trF\0"         "trL\0"  "trR\0"   // Fast
+    "bk\0"          "bkL\0"  "bkR\0"   // Reverse
+    // Simple
+    "\0"            // None
+    "rest\0"        // Rest
+    "\0"            // GyroToggle
+    "balance\0"     // Balance
+    "\0"            // Pause
+    "vt\0"          // Step
+    "sit\0"         // Sit
+    "str\0"         // Stretch
+    "hi\0"          // Greet
+    "pu\0"          // Pushup
+    "pee\0"         // Hydrant
+    "ck\0"          // Check
+    "pd\0"          // Dead
+    "zero\0"        // Zero
+    "lifted\0"      // Lifted
+    "dropped\0"     // Dropped
+    "rc\0"          // Recover
+    "\0"            // SaveServoCalibration
+    "\0"            // AbortServoCalibration
+    "\0"            // ShowJointAngles
+    "\0"            // ShowHelp
+    // With Args
+    "calib";        // Calibrate
+
+static constexpr uint8_t countNames(const char* names, uint16_t length) {
+    return (length == 0) ? 0 : (uint8_t)((*names == '\0') + countNames(names + 1, length - 1));
+}
+
+static_assert(countNames(SLOT_NAMES, sizeof(SLOT_NAMES)) == SKILL_SLOTS, "SLOT_NAMES needs one name per slot");
+static_assert(SKILL_SIMPLE_SLOTS == 21, "Command::Simple changed, update SLOT_NAMES");
+
+Slot slot(const Command::Command& command) {
+    switch (command.type()) {
+        case (Command::Type::Move): {
+            Command::Move cmd;
+            if (command.get(cmd)) {
+                return slot(cmd);
+            }
+            break;
+        }
+        case (Command::Type::Simple): {
+            Command::Simple cmd;
+            if (command.get(cmd)) {
+                return slot(cmd);
+            }
+            break;
+        }
+        case (Command::Type::WithArgs): {
+            Command::WithArgs cmd;
+            if (command.get(cmd) && (cmd.cmd == Command::ArgType::Calibrate)) {
+                return SKILL_SLOT_CALIBRATE;
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+    return SKILL_SLOT_NONE;
+}
+
+Command::Command slotCommand(Slot s) {
+    if (s < SKILL_MOVE_SLOTS) {
+        const uint8_t directions = (uint8_t)Command::Direction::TOTAL;
+        return Command::Command(Command::Move{(Command::Pace)(s / directions), (Command::Direction)(s % directions)});
+    }
+    if (s < SKILL_SLOT_CALIBRATE) {
+        return Command::Command((Command::Simple)(s - SKILL_MOVE_SLOTS));
+    }
+    if (s == SKILL_SLOT_CALIBRATE) {
+        return Command::Command(Command::WithArgs{Command::ArgType::Calibrate, 0, {}});
+    }
+    return Command::Command();
+}
+
+bool slotName(Slot s, char* name) {
+    name[0] = '\0';
+    if (s >= SKILL_SLOTS) {
+        return false;
+    }
+    const char* p = SLOT_NAMES;
+    for (Slot i = 0; i < s; i++) {
+        while (pgm_read_byte(p++) != '\0') {}
+    }
+    uint8_t length = 0;
+    while ((length < SKILL_NAME_SIZE - 1) && ((name[length] = (char)pgm_read_byte(p + length)) != '\0')) {
+        length++;
+    }
+    name[length] = '\0';
+    return length != 0;
+}
+
+Slot slotByName(const char* name) {
+    if (name[0] == '\0') {
+        return SKILL_SLOT_NONE; // Empty names are slots with no skill
+    }
+    const char* p = SLOT_NAMES;
+    for (Slot s = 0; s < SKILL_SLOTS; s++) {
+        const char* n = name;
+        char c;
+        while (((c = (char)pgm_read_byte(p++)) == *n) && (c != '\0')) {
+            n++;
+        }
+        if (c == *n) {
+            return s;
+        }
+        if (c != '\0') {
+            while (pgm_read_byte(p++) != '\0') {}
+        }
+    }
+    return SKILL_SLOT_NONE;
+}
+
+uint16_t slotHash(Slot s) {
+    char name[SKILL_NAME_SIZE];
+    return slotName(s, name) ? Index::hash(name) : SKILL_NO_HASH;
+}
+
+} // namespace Skill
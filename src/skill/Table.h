@@ -0,0 +1,55 @@
+//
+// Bittle Skill Table
+// Maps commands directly to skill slots
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_SKILL_TABLE_H_
+#define _BITTLEET_SKILL_TABLE_H_
+
+#include <stdint.h>
+#include "../command/Command.h"
+
+// Slots are laid out as: moves (pace major), simple commands, then calibrate.
+#define SKILL_MOVE_SLOTS ((uint8_t)Command::Pace::TOTAL * (uint8_t)Command::Direction::TOTAL)
+#define SKILL_SIMPLE_SLOTS ((uint8_t)Command::Simple::TOTAL)
+#define SKILL_SLOT_CALIBRATE (SKILL_MOVE_SLOTS + SKILL_SIMPLE_SLOTS)
+#define SKILL_SLOTS (SKILL_SLOT_CALIBRATE + 1)
+#define SKILL_SLOT_NONE (0xFF)
+
+#define SKILL_NO_HASH (0)
+#define SKILL_NAME_SIZE (8) // Longest instinct name, "balance", and its terminator
+
+namespace Skill {
+
+typedef uint8_t Slot;
+
+constexpr Slot slot(const Command::Move& move) {
+    return (uint8_t)move.pace * (uint8_t)Command::Direction::TOTAL + (uint8_t)move.direction;
+}
+
+constexpr Slot slot(const Command::Simple& simple) {
+    return SKILL_MOVE_SLOTS + (uint8_t)simple;
+}
+
+Slot slot(const Command::Command& command);
+
+// Inverse of slot(). Returns an empty command for SKILL_SLOT_NONE or an out of range slot.
+Command::Command slotCommand(Slot s);
+
+// Copies the instinct name for a slot into name, which must hold SKILL_NAME_SIZE.
+// Returns false, with an empty name, if the slot has no skill.
+bool slotName(Slot s, char* name);
+
+// Hash of the instinct name for a slot, or SKILL_NO_HASH if the slot has no skill.
+uint16_t slotHash(Slot s);
+
+// Inverse of slotName(). Returns SKILL_SLOT_NONE if no slot plays the named instinct.
+Slot slotByName(const char* name);
+
+}
+
+#endif // _BITTLEET_SKILL_TABLE_H_
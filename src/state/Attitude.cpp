@@ -21,84 +21,141 @@
 
 #define ACCEL_COEFF (0.05f)
 
+// Fixed point equivalents
+#define TRUST_BITS (15)
+#define TRUST_ONE ((uint16_t)1 << TRUST_BITS)
+#define TRUST_SHIFT (13) // Scales diff2 / NOMINAL_G2 to Q15, since NOMINAL_G2 is 2^28
+#define ACCEL_COEFF_Q20 (52429) // 0.05, with enough bits that rounding it does not bias the correction
+#define ACCEL_COEFF_BITS (20)
+#define GYRO_BINARY_ANGLE_PER_LSB_US (11930) // Half of RAD_PER_S_PER_LSB * BINARY_ANGLE_PER_RAD / US_PER_SEC, in Q16, for the trapezoid
+#define GYRO_RATE_SHIFT (9) // The Q16 rate is cut to Q7, so a rate times a chunk of dt fits in 32 bits
+#define GYRO_RATE_BITS (16 - GYRO_RATE_SHIFT)
+#define GYRO_CHUNK_BITS (10) // dt is split into whole 1024us chunks and the rest
+
 namespace Attitude {
 
-void Attitude::update(const Measurement& m) {
+// The steps of the filter for each angle type. Each has the same shape as the float filter.
+template <typename T> struct FilterMath;
+
+template <> struct FilterMath<float> {
+    static float integrate(int16_t gyro, int16_t gyroLast, uint32_t dtUs) {
+        const float dt = (float)dtUs/(float)US_PER_SEC;
+        return 0.5f * (RAD_PER_S_PER_LSB * ((float)gyro + (float)gyroLast)) * dt;
+    }
+    static float wrap(float angle) { return wrapPiToNegPi(angle); }
+    static float measure(int32_t y, int32_t x) { return fastAtan2((float)y, (float)x); }
+    static float trust(int32_t diff2) {
+        const float trust = 1.0f - 5.0f * ((float)diff2 / (float)NOMINAL_G2);
+        if (trust < 0.0) {
+            return 0.0;
+        }
+        return trust;
+    }
+    static float correct(float predict, float measurement, float trust) {
+        const float diff = shortestRadianPath(predict, measurement);
+        return wrapPiToNegPi(applyIIR(predict + diff, predict, trust * ACCEL_COEFF));
+    }
+    static float toRadians(float angle) { return angle; }
+};
+
+template <> struct FilterMath<BinaryAngle> {
+    static BinaryAngle integrate(int16_t gyro, int16_t gyroLast, uint32_t dtUs) {
+        // No 64 bit multiply, which the AVR only has through a slow libgcc helper.
+        // A full scale sum times the Q16 constant is under 2^30, and the rate times the rest of a chunk under 2^31.
+        // Whole chunks are exact in Q7, so their product only wraps, the same as the angle it adds to.
+        const int32_t sum = (int32_t)gyro + gyroLast;
+        const int32_t rate = (sum * GYRO_BINARY_ANGLE_PER_LSB_US + (1L << (GYRO_RATE_SHIFT - 1))) >> GYRO_RATE_SHIFT;
+        const uint32_t chunks = dtUs >> GYRO_CHUNK_BITS;
+        const int32_t rest = (int32_t)(dtUs & ((1UL << GYRO_CHUNK_BITS) - 1));
+        const uint32_t whole = (uint32_t)rate * (chunks << (GYRO_CHUNK_BITS - GYRO_RATE_BITS));
+        return (BinaryAngle)(whole + (uint32_t)((rate * rest) >> GYRO_RATE_BITS));
+    }
+    static BinaryAngle wrap(BinaryAngle angle) { return angle; } // Overflow already did it
+    static BinaryAngle measure(int32_t y, int32_t x) { return atan2Binary(y, x); }
+    static uint16_t trust(int32_t diff2) {
+        if (diff2 >= NOMINAL_G2 / 5) {
+            return 0;
+        }
+        return TRUST_ONE - (uint16_t)((diff2 * 5) >> TRUST_SHIFT);
+    }
+    static BinaryAngle correct(BinaryAngle predict, BinaryAngle measurement, uint16_t trust) {
+        const int32_t diff = (int32_t)((uint32_t)measurement - (uint32_t)predict); // Shortest path, for free
+        const int32_t coeff = ((int32_t)trust * ACCEL_COEFF_Q20) >> TRUST_BITS;
+        const int32_t step = ((diff >> 16) * coeff) >> (ACCEL_COEFF_BITS - 16); // A Q20 fraction of a 16 bit angle, back up to 32 bits
+        return (BinaryAngle)((uint32_t)predict + (uint32_t)step);
+    }
+    static float toRadians(BinaryAngle angle) { return binaryAngleToRadians(angle); }
+};
 
-    const float dt = (float)(m.us - _usUpdate)/(float)US_PER_SEC;
+template <typename T>
+void Filter<T>::update(const Measurement& m) {
+    typedef FilterMath<T> Math;
 
-    const float rollIntegrated = 0.5f * (RAD_PER_S_PER_LSB * ((float)m.gyro.x + (float)_gyroLastX)) * dt;
-    const float pitchIntegrated = 0.5f * (RAD_PER_S_PER_LSB * ((float)m.gyro.y + (float)_gyroLastY)) * dt;
+    const uint32_t dtUs = m.us - _usUpdate;
 
-    const float rollPredict = wrapPiToNegPi(_roll + rollIntegrated);
-    const float pitchPredict = wrapPiToNegPi(_pitch + pitchIntegrated);
+    const T rollPredict = Math::wrap(_roll + Math::integrate(m.gyro.x, _gyroLastX, dtUs));
+    const T pitchPredict = Math::wrap(_pitch + Math::integrate(m.gyro.y, _gyroLastY, dtUs));
 
     _gyroLastX = m.gyro.x;
     _gyroLastY = m.gyro.y;
 
-    const float trust = _computeTrust(m);
-    if (trust == 0.0) {
+    const TrustType trust = _computeTrust(m);
+    if (trust == 0) {
         if (_reset == false) {
             _roll = rollPredict;
             _pitch = pitchPredict;
         }
     } else {
-        const float rollMeasurement = (float)atan2(m.accel.y, m.accel.z);
-        const float pitchMeasurement = (float)atan2(-m.accel.x, m.accel.z);
+        const T rollMeasurement = Math::measure(m.accel.y, m.accel.z);
+        const T pitchMeasurement = Math::measure(-(int32_t)m.accel.x, m.accel.z);
         if (_reset) {
             _roll = rollMeasurement;
             _pitch = pitchMeasurement;
             _reset = false;
         } else {
-            const float rollDiff = shortestRadianPath(rollPredict, rollMeasurement);
-            const float pitchDiff = shortestRadianPath(pitchPredict, pitchMeasurement);
-
-            _roll = wrapPiToNegPi(applyIIR(rollPredict + rollDiff, rollPredict, trust * ACCEL_COEFF));
-            _pitch = wrapPiToNegPi(applyIIR(pitchPredict + pitchDiff, pitchPredict, trust * ACCEL_COEFF));
+            _roll = Math::correct(rollPredict, rollMeasurement, trust);
+            _pitch = Math::correct(pitchPredict, pitchMeasurement, trust);
         }
     }
     _usUpdate = m.us;
 }
 
-float Attitude::_computeTrust(const Measurement& m) const {
+template <typename T>
+void Filter<T>::updateBatch(const Measurement* m, uint8_t n) {
+    for (uint8_t i = 0; i < n; i++) {
+        update(m[i]);
+    }
+}
+
+template <typename T>
+typename Filter<T>::TrustType Filter<T>::_computeTrust(const Measurement& m) const {
     const int32_t accel2 = ((int32_t)m.accel.x * (int32_t)m.accel.x) +
                            ((int32_t)m.accel.y * (int32_t)m.accel.y) + 
                            ((int32_t)m.accel.z * (int32_t)m.accel.z);
     int32_t diff2 = accel2 - NOMINAL_G2;
     diff2 = (diff2 < 0) ? -diff2 : diff2;
-    const float trust = 1.0f - 5.0f * ((float)diff2 / (float)NOMINAL_G2);
-    if (trust < 0.0) {
-        return 0.0;
-    }
-    return trust;
+    return FilterMath<T>::trust(diff2);
 }
 
-void Attitude::reset() {
-    _roll = 0.0;
-    _pitch = 0.0;
+template <typename T>
+void Filter<T>::reset() {
+    _roll = 0;
+    _pitch = 0;
     _reset = true;
 }
 
-float Attitude::angleFromAxis(Axis axis) const {
-    switch (axis) {
-        case Axis::Roll: {
-            return _roll;
-        }
-        case Axis::Pitch: {
-            return _pitch;
-        }
-        default: {
-            return 0.0f;
-        }
-    }
+template <typename T>
+float Filter<T>::roll() const {
+    return FilterMath<T>::toRadians(_roll);
 }
 
-float Attitude::angleFromAxis(int8_t axis) const {
-    Axis a = static_cast<Axis>(abs(axis));
-    return angleFromAxis(a); 
+template <typename T>
+float Filter<T>::pitch() const {
+    return FilterMath<T>::toRadians(_pitch);
 }
 
-
+template class Filter<float>;
+template class Filter<BinaryAngle>;
 
 } // namespace Attitude
 
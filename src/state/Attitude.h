@@ -13,15 +13,11 @@
 #include <Arduino.h>
 #include <stdint.h>
 #include "Status.h"
+#include "Provider.h"
+#include "../math/FastTrig.h"
 
 namespace Attitude {
 
-enum class Axis : uint8_t {
-    Yaw = 0,
-    Pitch,
-    Roll
-};
-
 struct Vec3 {
     int16_t x, y, z;
 };
@@ -32,22 +28,33 @@ struct Measurement {
     Vec3 gyro;
 };
 
-class Attitude {
+// How far the accelerometer can be trusted, from 0 to 1.
+template <typename T> struct Trust { typedef float Type; };
+template <> struct Trust<BinaryAngle> { typedef uint16_t Type; }; // Q15
+
+// Complementary filter over the raw accel and gyro.
+// T is the angle type the filter runs in: float radians, or BinaryAngle, which needs no soft float at all.
+// Only the float and BinaryAngle filters are built; see Attitude.cpp.
+template <typename T>
+class Filter : public Provider {
 public:
-    Attitude() = default;
+    typedef typename Trust<T>::Type TrustType;
+
+    Filter() = default;
 
     void update(const Measurement& m);
+    void updateBatch(const Measurement* m, uint8_t n); // In sample order, oldest first
     void reset();
 
-    float angleFromAxis(Axis axis) const;
-    float angleFromAxis(int8_t axis) const;
-    float roll() const { return _roll; }
-    float pitch() const { return _pitch; }
+    float roll() const;
+    float pitch() const;
+    T rollAngle() const { return _roll; }
+    T pitchAngle() const { return _pitch; }
 protected:
-    float _computeTrust(const Measurement& m) const;
+    TrustType _computeTrust(const Measurement& m) const;
 
-    float _roll = 0.0;
-    float _pitch = 0.0;
+    T _roll = 0;
+    T _pitch = 0;
 
     int16_t _gyroLastX = 0;
     int16_t _gyroLastY = 0;
@@ -56,6 +63,9 @@ protected:
     bool _reset = true;
 };
 
+typedef Filter<float> Attitude;
+typedef Filter<BinaryAngle> AttitudeFixed;
+
 }
 
 #endif // _BITTLEET_ATTITUDE_H_
@@ -0,0 +1,59 @@
+//
+// IMU Data Ready
+// Timestamps MPU6050 samples from its data ready interrupt
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "DataReady.h"
+
+#include <Arduino.h>
+
+namespace Attitude {
+
+DataReady* DataReady::_attached = NULL;
+
+void DataReady::attach(uint8_t interrupt) {
+    _attached = this;
+    attachInterrupt(interrupt, _onInterrupt, RISING);
+}
+
+void DataReady::_onInterrupt() {
+    _attached->capture(micros());
+}
+
+void DataReady::capture(uint32_t us) {
+    const uint8_t head = _head;
+    if ((uint8_t)(head - _tail) >= DATA_READY_SIZE) {
+        _overflows++;
+        return;
+    }
+    _ring[head & (DATA_READY_SIZE - 1)] = us;
+    _head = head + 1; // Publish only once the stamp is written
+}
+
+bool DataReady::waitForNext(uint16_t timeoutUs) {
+    clear(); // A full ring would not move the head
+    const uint8_t head = _head;
+    for (uint16_t waited = 0; waited < timeoutUs; waited += DATA_READY_POLL_US) {
+        if (_head != head) {
+            return true;
+        }
+        delayMicroseconds(DATA_READY_POLL_US);
+    }
+    return (_head != head);
+}
+
+bool DataReady::pop(uint32_t& us) {
+    const uint8_t tail = _tail;
+    if (tail == _head) {
+        return false;
+    }
+    us = _ring[tail & (DATA_READY_SIZE - 1)];
+    _tail = tail + 1;
+    return true;
+}
+
+} // namespace Attitude
@@ -0,0 +1,57 @@
+//
+// IMU Data Ready
+// Timestamps MPU6050 samples from its data ready interrupt
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_DATA_READY_H_
+#define _BITTLEET_DATA_READY_H_
+
+#include <stdint.h>
+
+#define DATA_READY_SIZE (16) // Must be a power of two, and hold more than IMU_FIFO_MAX_BACKLOG
+#define DATA_READY_POLL_US (10)
+
+namespace Attitude {
+
+// The interrupt can't read the sample itself, since I2C needs interrupts, so it only records when the sample was taken.
+// The samples are read later from the FIFO in the same order, and ImuFifo pairs them up with these stamps.
+//
+// Single producer, single consumer. The interrupt writes the head and the attitude task writes the tail,
+// and both are single bytes, so neither side has to disable interrupts.
+class DataReady {
+  public:
+    DataReady() = default;
+
+    // Captures on the rising edge of the given interrupt. Only one DataReady can be attached.
+    void attach(uint8_t interrupt);
+
+    // Producer side, called from the interrupt. A full ring drops the stamp and counts an overflow.
+    void capture(uint32_t us);
+
+    // Consumer side
+    bool pop(uint32_t& us);
+    void clear() { _tail = _head; } // When the FIFO is reset, its samples' stamps go too
+    // Drops the stamps held and waits for the next one, so the caller starts just after a sample is taken.
+    // Returns false if nothing is captured within timeoutUs.
+    bool waitForNext(uint16_t timeoutUs);
+
+    uint8_t size() const { return (uint8_t)(_head - _tail); }
+    uint16_t overflows() const { return _overflows; }
+
+  protected:
+    static void _onInterrupt();
+    static DataReady* _attached;
+
+    uint32_t _ring[DATA_READY_SIZE];
+    volatile uint8_t _head = 0; // Free running, written by the interrupt
+    volatile uint8_t _tail = 0; // Free running, written by the consumer
+    volatile uint16_t _overflows = 0;
+};
+
+}
+
+#endif // _BITTLEET_DATA_READY_H_
@@ -0,0 +1,43 @@
+//
+// DMP Attitude
+// Attitude from the quaternion the MPU6050's DMP fuses on chip
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Dmp.h"
+#include <Arduino.h>
+
+namespace Attitude {
+
+static inline float readQ14(const uint8_t* bytes) {
+    return (float)(int16_t)(((uint16_t)bytes[0] << 8) | bytes[1]) / DMP_QUATERNION_ONE;
+}
+
+Quaternion Quaternion::fromPacket(const uint8_t* packet) {
+    return Quaternion{readQ14(packet + 0), readQ14(packet + 4), readQ14(packet + 8), readQ14(packet + 12)};
+}
+
+void Dmp::update(const Quaternion& q) {
+    // Gravity in the sensor frame, pointing up like the accelerometer reading at rest
+    float gx = 2.0f * (q.x * q.z - q.w * q.y);
+    float gy = 2.0f * (q.w * q.x + q.y * q.z);
+    const float gz = q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z;
+    if (_turnedAround) {
+        gx = -gx;
+        gy = -gy;
+    }
+    _roll = atan2(gy, gz);
+    _pitch = atan2(-gx, gz);
+    _yaw = atan2(2.0f * (q.w * q.z + q.x * q.y), 1.0f - 2.0f * (q.y * q.y + q.z * q.z));
+}
+
+void Dmp::reset() {
+    _roll = 0.0f;
+    _pitch = 0.0f;
+    _yaw = 0.0f;
+}
+
+} // namespace Attitude
@@ -0,0 +1,50 @@
+//
+// DMP Attitude
+// Attitude from the quaternion the MPU6050's DMP fuses on chip
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_ATTITUDE_DMP_H_
+#define _BITTLEET_ATTITUDE_DMP_H_
+
+#include <stdint.h>
+#include "Provider.h"
+
+#define DMP_QUATERNION_ONE (16384.0f) // The MotionApps 2.0 packet's quaternion is Q14 in the top half of each word
+
+namespace Attitude {
+
+struct Quaternion {
+    float w, x, y, z;
+
+    static Quaternion fromPacket(const uint8_t* packet);
+};
+
+// The DMP does the fusion, so an update is only the trig to turn its quaternion into angles.
+// Roll and pitch are taken from the gravity vector with the same formulas as the complementary filter,
+// so the two providers agree on range and sign.
+class Dmp : public Provider {
+public:
+    // Bittle's IMU is mounted turned half way round about z, which the raw path corrects by negating accel x and y.
+    explicit Dmp(bool turnedAround = false) : _turnedAround(turnedAround) {}
+
+    void update(const Quaternion& q);
+    void reset();
+
+    float roll() const { return _roll; }
+    float pitch() const { return _pitch; }
+    float yaw() const { return _yaw; }
+
+protected:
+    bool _turnedAround;
+    float _roll = 0.0f;
+    float _pitch = 0.0f;
+    float _yaw = 0.0f;
+};
+
+}
+
+#endif // _BITTLEET_ATTITUDE_DMP_H_
@@ -0,0 +1,55 @@
+//
+// IMU FIFO
+// Decodes batches of MPU6050 FIFO samples into evenly timestamped measurements
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "ImuFifo.h"
+
+namespace Attitude {
+
+static inline int16_t readBigEndian(const uint8_t* bytes) {
+    return (int16_t)(((uint16_t)bytes[0] << 8) | bytes[1]);
+}
+
+uint8_t ImuFifo::pending(uint16_t fifoCount) {
+    const uint16_t samples = fifoCount / IMU_FIFO_SAMPLE_BYTES;
+    if ((samples > IMU_FIFO_MAX_BACKLOG) || (fifoCount % IMU_FIFO_SAMPLE_BYTES != 0)) {
+        _overflows++; // A partial sample means the FIFO wrapped and the stream is misaligned
+        return 0;
+    }
+    return (samples < IMU_FIFO_BATCH) ? samples : IMU_FIFO_BATCH;
+}
+
+void ImuFifo::decode(const uint8_t* bytes, uint8_t samples, uint32_t nowUs, Measurement* out, DataReady* ready) {
+    if (samples == 0) {
+        return;
+    }
+    if (!_started) {
+        // The newest sample was taken about now
+        _lastUs = nowUs - (uint32_t)samples * IMU_SAMPLE_PERIOD_US;
+        _started = true;
+    }
+    for (uint8_t s = 0; s < samples; s++) {
+        const uint8_t* sample = bytes + s * IMU_FIFO_SAMPLE_BYTES;
+        Measurement& m = out[s];
+        uint32_t stamp;
+        if ((ready != NULL) && ready->pop(stamp)) {
+            _lastUs = stamp;
+        } else {
+            _lastUs += IMU_SAMPLE_PERIOD_US;
+        }
+        m.us = _lastUs;
+        m.accel.x = readBigEndian(sample + 0);
+        m.accel.y = readBigEndian(sample + 2);
+        m.accel.z = readBigEndian(sample + 4);
+        m.gyro.x = readBigEndian(sample + 6);
+        m.gyro.y = readBigEndian(sample + 8);
+        m.gyro.z = readBigEndian(sample + 10);
+    }
+}
+
+} // namespace Attitude
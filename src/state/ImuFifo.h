@@ -0,0 +1,51 @@
+//
+// IMU FIFO
+// Decodes batches of MPU6050 FIFO samples into evenly timestamped measurements
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_IMU_FIFO_H_
+#define _BITTLEET_IMU_FIFO_H_
+
+#include <stdint.h>
+#include "Attitude.h"
+#include "DataReady.h"
+
+#define IMU_FIFO_SAMPLE_BYTES (12)       // Accel x, y, z then gyro x, y, z, each big endian
+#define IMU_FIFO_BATCH (2)               // Samples read per tick; 24 bytes fits one 32 byte Wire transfer
+#define IMU_FIFO_MAX_BACKLOG (8)         // Samples queued before the FIFO is too far behind to be worth draining
+#define IMU_SAMPLE_RATE_DIVIDER (4)      // 1kHz gyro output rate with the DLPF on, so 200Hz
+#define IMU_SAMPLE_PERIOD_US (5000)
+
+namespace Attitude {
+
+// The MPU6050 samples at a fixed rate, so only the first sample after a restart is stamped from the clock.
+// Every later sample is exactly IMU_SAMPLE_PERIOD_US after the one before, whenever it happens to be read.
+// With the data ready interrupt wired up, samples take the stamp it captured instead.
+class ImuFifo {
+  public:
+    ImuFifo() = default;
+
+    // Samples to read from a FIFO holding fifoCount bytes. Returns zero and counts an overflow when the backlog
+    // is too old to use; the caller should then reset the FIFO and call restart().
+    uint8_t pending(uint16_t fifoCount);
+
+    // Decodes samples read in one burst at nowUs, taking stamps from ready while it has them.
+    void decode(const uint8_t* bytes, uint8_t samples, uint32_t nowUs, Measurement* out, DataReady* ready = NULL);
+
+    void restart() { _started = false; }
+    bool started() const { return _started; }
+    uint16_t overflows() const { return _overflows; }
+
+  protected:
+    uint32_t _lastUs = 0;
+    bool _started = false;
+    uint16_t _overflows = 0;
+};
+
+}
+
+#endif // _BITTLEET_IMU_FIFO_H_
@@ -0,0 +1,37 @@
+//
+// Attitude Provider
+// Interface to whatever is working out the body attitude
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "Provider.h"
+#include <Arduino.h>
+
+namespace Attitude {
+
+float Provider::angleFromAxis(Axis axis) const {
+    switch (axis) {
+        case Axis::Roll: {
+            return roll();
+        }
+        case Axis::Pitch: {
+            return pitch();
+        }
+        case Axis::Yaw: {
+            return yaw();
+        }
+        default: {
+            return 0.0f;
+        }
+    }
+}
+
+float Provider::angleFromAxis(int8_t axis) const {
+    Axis a = static_cast<Axis>(abs(axis));
+    return angleFromAxis(a); 
+}
+
+} // namespace Attitude
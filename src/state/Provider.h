@@ -0,0 +1,38 @@
+//
+// Attitude Provider
+// Interface to whatever is working out the body attitude
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#ifndef _BITTLEET_ATTITUDE_PROVIDER_H_
+#define _BITTLEET_ATTITUDE_PROVIDER_H_
+
+#include <stdint.h>
+
+namespace Attitude {
+
+enum class Axis : uint8_t {
+    Yaw = 0,
+    Pitch,
+    Roll
+};
+
+// Angles are in radians, from -pi to pi. How they are updated depends on the provider, since each reads the IMU differently.
+class Provider {
+public:
+    virtual void reset() = 0;
+
+    virtual float roll() const = 0;
+    virtual float pitch() const = 0;
+    virtual float yaw() const { return 0.0f; } // Zero for providers which can't tell
+
+    float angleFromAxis(Axis axis) const;
+    float angleFromAxis(int8_t axis) const; // Sign is ignored
+};
+
+}
+
+#endif // _BITTLEET_ATTITUDE_PROVIDER_H_
@@ -10,6 +10,7 @@
 
 #include "Comms.h"
 #include "../Bittle.h"
+#include "../skill/Table.h"
 
 //token list
 #define T_ABORT     'a'
@@ -25,6 +26,7 @@
 #define T_SIMULTANEOUS_MOVE 'M'
 #define T_MELODY    'o'
 #define T_PAUSE     'p'
+#define T_SEQUENCE  'q'         //pairs of instinct name and amount: cycles if positive, tenths of a second if negative
 #define T_RESET     'r'
 #define T_SAVE      's'
 #define T_SKILL     'k'
@@ -100,6 +102,7 @@ bool SerialComms::_parseSingle(uint8_t byte, Command::Command& result) {
         case T_MEOW:                _toArgs(Command::ArgType::Meow); break;
         case T_BEEP:                _toArgs(Command::ArgType::Beep); break;
         case T_SIMULTANEOUS_MOVE:   _toArgs(Command::ArgType::MoveSimultaneously); break;
+        case T_SEQUENCE:            _toArgs(Command::ArgType::Sequence); break;
         // Skill - the next byte will determine which skill
         case T_SKILL:               _state = State::Skill; break;
         default: { break; } // Try again.
@@ -182,7 +185,15 @@ bool SerialComms::_extractArgsFromString(Command::WithArgs& cmd) {
         }
         int16_t argPair[2] = {};
         for (int i = 0; i<2; i++) {
-            argPair[i] = atoi(pch);
+            if ((i == 0) && (_argType == Command::ArgType::Sequence)) {
+                const Skill::Slot s = Skill::slotByName(pch);
+                if (s == SKILL_SLOT_NONE) {
+                    return false; // Unknown skill
+                }
+                argPair[i] = s;
+            } else {
+                argPair[i] = atoi(pch);
+            }
             pch = strtok(NULL, " ,\t");
             if ((i == 0) && (pch == NULL)) {
                 return true; // Args are expected to arrive in pairs. Still assume we have a valid arg set.
@@ -0,0 +1,62 @@
+//
+// Skill Arena Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include "Arduino.h"
+
+#include "skill/Arena.h"
+
+TEST_CASE("Arena::allocate", "[Arena]" ) 
+{
+    Skill::Arena<32> arena;
+    REQUIRE(arena.capacity() == 32);
+    REQUIRE(arena.used() == 0);
+
+    SECTION("sequential allocations do not overlap") {
+        char* a = arena.allocate(10);
+        char* b = arena.allocate(22);
+        REQUIRE(a != NULL);
+        REQUIRE(b == a + 10);
+        REQUIRE(arena.used() == 32);
+    }
+
+    SECTION("fails when full") {
+        REQUIRE(arena.allocate(20) != NULL);
+        REQUIRE(arena.allocate(13) == NULL);
+        REQUIRE(arena.used() == 20);
+        REQUIRE(arena.allocate(12) != NULL);
+        REQUIRE(arena.allocate(1) == NULL);
+    }
+
+    SECTION("too large") {
+        REQUIRE(arena.allocate(33) == NULL);
+        REQUIRE(arena.used() == 0);
+    }
+
+    SECTION("reset reuses storage") {
+        char* a = arena.allocate(16);
+        arena.reset();
+        REQUIRE(arena.used() == 0);
+        REQUIRE(arena.allocate(16) == a);
+    }
+}
+
+TEST_CASE("Arena::highWatermark", "[Arena]" ) 
+{
+    Skill::Arena<64> arena;
+    REQUIRE(arena.highWatermark() == 0);
+    arena.allocate(20);
+    arena.allocate(10);
+    REQUIRE(arena.highWatermark() == 30);
+    arena.reset();
+    arena.allocate(5);
+    REQUIRE(arena.highWatermark() == 30);
+    arena.allocate(40);
+    REQUIRE(arena.highWatermark() == 45);
+}
@@ -22,9 +22,22 @@
 #define NOMINAL_G_2_AXES (11585)
 #define NOMINAL_G_3_AXES (9459)
 
+// Every vector is replayed against the fixed point filter too, which may be this far from the float filter.
+#define FIXED_DIVERGENCE (1e-4)
+
 using Measurement = Attitude::Measurement;
 using Vec3 = Attitude::Vec3;
 
+// Binary angles read pi as -pi, so compare by the shortest path.
+static void nearAngle(double expected, double result, double tol) {
+    NEAR(0.0, shortestRadianPath(expected, result), tol);
+}
+
+static void requireFixedMatches(const Attitude::Attitude& attitude, const Attitude::AttitudeFixed& fixed) {
+    nearAngle(attitude.roll(), fixed.roll(), FIXED_DIVERGENCE);
+    nearAngle(attitude.pitch(), fixed.pitch(), FIXED_DIVERGENCE);
+}
+
 TEST_CASE("Attitude::Update_Accel", "[Attitude]" ) 
 { 
     struct TestCase {
@@ -81,6 +94,12 @@ TEST_CASE("Attitude::Update_Accel", "[Attitude]" )
             NEAR(tc.expectedPitch, attitude.pitch(), 1e-3f);
             NEAR(tc.expectedRoll, attitude.angleFromAxis(Attitude::Axis::Roll), 1e-3f);
             NEAR(tc.expectedPitch, attitude.angleFromAxis(Attitude::Axis::Pitch), 1e-3f);
+
+            Attitude::AttitudeFixed fixed{};
+            fixed.update(tc.input);
+            nearAngle(tc.expectedRoll, fixed.roll(), 1e-3f);
+            nearAngle(tc.expectedPitch, fixed.pitch(), 1e-3f);
+            requireFixedMatches(attitude, fixed);
         }
     }
 }
@@ -123,14 +142,13 @@ TEST_CASE("Attitude::Update_Gyro", "[Attitude]" )
 
     for (auto& tc : testCases) {
         SECTION(tc.name) {
+            const Measurement level = Measurement{
+                .us = 0, 
+                .accel = Vec3{0, 0, NOMINAL_G},
+                .gyro = Vec3{0, 0, 0}, 
+            };
             Attitude::Attitude attitude = Attitude::Attitude();
-            attitude.update(
-                Measurement{
-                    .us = 0, 
-                    .accel = Vec3{0, 0, NOMINAL_G},
-                    .gyro = Vec3{0, 0, 0}, 
-                }
-            );
+            attitude.update(level);
 
             float tol = std::max((abs(tc.expectedPitch) + abs(tc.expectedRoll)) * 1e-3, 1e-6);
 
@@ -139,10 +157,36 @@ TEST_CASE("Attitude::Update_Gyro", "[Attitude]" )
             NEAR(tc.expectedPitch, attitude.pitch(), tol);
             NEAR(tc.expectedRoll, attitude.angleFromAxis(Attitude::Axis::Roll), tol);
             NEAR(tc.expectedPitch, attitude.angleFromAxis(Attitude::Axis::Pitch), tol);
+
+            Attitude::AttitudeFixed fixed{};
+            fixed.update(level);
+            fixed.update(tc.input);
+            requireFixedMatches(attitude, fixed);
         }
     }
 }
 
+TEST_CASE("Attitude::Update_Gyro full scale", "[Attitude]" ) 
+{
+    // The largest gyro sum over a long sample period is the worst case for the 32 bit fixed point integration.
+    for (int16_t sign = -1; sign <= 1; sign += 2) {
+        const int16_t rate = sign * 32767;
+        const Measurement first = Measurement{.us = 0, .accel = Vec3{0, 0, NOMINAL_G}, .gyro = Vec3{rate, (int16_t)-rate, 0}};
+        const Measurement second = Measurement{.us = 10000, .accel = Vec3{0, 0, 0}, .gyro = Vec3{rate, (int16_t)-rate, 0}};
+
+        Attitude::Attitude attitude = Attitude::Attitude();
+        attitude.update(first);
+        attitude.update(second);
+        NEAR(sign * 0.17452, attitude.roll(), 1e-4);
+        NEAR(-sign * 0.17452, attitude.pitch(), 1e-4);
+
+        Attitude::AttitudeFixed fixed{};
+        fixed.update(first);
+        fixed.update(second);
+        requireFixedMatches(attitude, fixed);
+    }
+}
+
 TEST_CASE("Attitude::Update_Gyro_Trapezoidal", "[Attitude]" ) 
 { 
     struct Step {
@@ -175,18 +219,62 @@ TEST_CASE("Attitude::Update_Gyro_Trapezoidal", "[Attitude]" )
     };
 
     Attitude::Attitude attitude = Attitude::Attitude();
+    Attitude::AttitudeFixed fixed{};
 
     for (auto& step : steps) {
         const float tol = std::max((abs(step.expectedPitch) + abs(step.expectedRoll)) * 1e-3, 1e-6);
         
         attitude.update(step.input);
+        fixed.update(step.input);
 
         NEAR(step.expectedRoll, attitude.roll(), tol);
         NEAR(step.expectedPitch, attitude.pitch(), tol);
+        requireFixedMatches(attitude, fixed);
     }
 }
 
+TEST_CASE("Attitude::UpdateBatch", "[Attitude]" ) 
+{
+    std::vector<Measurement> samples;
+    for (uint32_t i = 0; i < 20; i++) {
+        samples.push_back(Measurement{.us = i * 5000, .accel = Vec3{0, NOMINAL_G_2_AXES, NOMINAL_G_2_AXES}, .gyro = Vec3{(int16_t)(RAD_PER_S / 4), 0, 0}});
+    }
 
+    Attitude::Attitude single = Attitude::Attitude();
+    for (auto& m : samples) {
+        single.update(m);
+    }
+
+    SECTION("matches updating one at a time") {
+        Attitude::Attitude batched = Attitude::Attitude();
+        for (size_t i = 0; i < samples.size(); i += 4) {
+            batched.updateBatch(&samples[i], 4);
+        }
+        REQUIRE(batched.roll() == single.roll());
+        REQUIRE(batched.pitch() == single.pitch());
+    }
+
+    SECTION("fixed point batches match too") {
+        Attitude::AttitudeFixed fixed{};
+        Attitude::AttitudeFixed batched{};
+        for (auto& m : samples) {
+            fixed.update(m);
+        }
+        for (size_t i = 0; i < samples.size(); i += 4) {
+            batched.updateBatch(&samples[i], 4);
+        }
+        REQUIRE(batched.rollAngle() == fixed.rollAngle());
+        REQUIRE(batched.pitchAngle() == fixed.pitchAngle());
+        requireFixedMatches(single, fixed);
+    }
+
+    SECTION("an empty batch changes nothing") {
+        Attitude::Attitude batched = single;
+        batched.updateBatch(NULL, 0);
+        REQUIRE(batched.roll() == single.roll());
+        REQUIRE(batched.pitch() == single.pitch());
+    }
+}
 
 TEST_CASE("Attitude::Reset", "[Attitude]" ) 
 {
@@ -210,15 +298,21 @@ TEST_CASE("Attitude::Reset", "[Attitude]" )
     };
 
     Attitude::Attitude attitude{};
+    Attitude::AttitudeFixed fixed{};
     
     for (auto& step: steps) {
         attitude.reset();
         REQUIRE(0.0 == attitude.pitch());
         REQUIRE(0.0 == attitude.roll());
+        fixed.reset();
+        REQUIRE(0.0 == fixed.pitch());
+        REQUIRE(0.0 == fixed.roll());
 
         attitude.update(step.input);
         NEAR(step.expectedRoll, attitude.roll(), 1e-3f);
         NEAR(step.expectedPitch, attitude.pitch(), 1e-3f);
+        fixed.update(step.input);
+        requireFixedMatches(attitude, fixed);
     }
 }
 
@@ -233,6 +327,15 @@ TEST_CASE("Attitude::Update_GravityFilter", "[Attitude]" )
         }
     };
 
+    class FixedWhitebox : Attitude::AttitudeFixed {
+    public:
+        FixedWhitebox() = default;
+
+        float computeTrust(const Measurement& m) const {
+            return _computeTrust(m) / 32768.0f;
+        }
+    };
+
     struct TestCase {
         std::string name;
         Attitude::Measurement input;
@@ -293,6 +396,39 @@ TEST_CASE("Attitude::Update_GravityFilter", "[Attitude]" )
         SECTION(tc.name) {
             Whitebox attitude{};
             NEAR(tc.expectedTrust, attitude.computeTrust(tc.input), tol);
+            FixedWhitebox fixed{};
+            NEAR(attitude.computeTrust(tc.input), fixed.computeTrust(tc.input), 1e-3);
         }
     }
 }
+
+TEST_CASE("Attitude fixed point divergence", "[Attitude]" ) 
+{
+    // A long run of noisy samples at 200Hz, rocking about both axes and tumbling right over in roll.
+    Attitude::Attitude attitude{};
+    Attitude::AttitudeFixed fixed{};
+    uint32_t seed = 1;
+    double worst = 0.0;
+    for (uint32_t i = 0; i < 4000; i++) {
+        seed = seed * 1103515245 + 12345;
+        const int16_t noise = (int16_t)((seed >> 16) & 0xFF) - 128;
+        const float roll = (i < 2000) ? 0.6f * sinf(i * 0.01f) : (i - 2000) * 0.004f;
+        const float pitch = 0.4f * sinf(i * 0.013f);
+        const Measurement m = Measurement{
+            .us = i * 5000,
+            .accel = Vec3{
+                (int16_t)(-sinf(pitch) * NOMINAL_G + noise),
+                (int16_t)(sinf(roll) * cosf(pitch) * NOMINAL_G - noise),
+                (int16_t)(cosf(roll) * cosf(pitch) * NOMINAL_G + noise),
+            },
+            .gyro = Vec3{(int16_t)(noise * 4), (int16_t)(-noise * 2), 0},
+        };
+        attitude.update(m);
+        fixed.update(m);
+        const double rollDiff = fabs(shortestRadianPath(attitude.roll(), fixed.roll()));
+        const double pitchDiff = fabs(shortestRadianPath(attitude.pitch(), fixed.pitch()));
+        worst = (rollDiff > worst) ? rollDiff : worst;
+        worst = (pitchDiff > worst) ? pitchDiff : worst;
+    }
+    REQUIRE(worst < FIXED_DIVERGENCE);
+}
@@ -0,0 +1,178 @@
+//
+// Behaviour Executor Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+
+#include "skill/Behaviour.h"
+#include "math/Trig.h"
+
+using Action = Skill::Behaviour::Action;
+
+// Frame angles are all set to the frame number, so moves can be told apart.
+static std::vector<char> behaviourSpec(const std::vector<std::vector<int8_t>>& suffixes) {
+    std::vector<char> spec;
+    for (size_t f = 0; f < suffixes.size(); f++) {
+        for (uint8_t i = 0; i < DOF; i++) {
+            spec.push_back((char)f);
+        }
+        for (int8_t value : suffixes[f]) {
+            spec.push_back((char)value);
+        }
+    }
+    return spec;
+}
+
+static Skill::Skill behaviourSkill(std::vector<char>& spec, uint8_t frames, Skill::LoopSpec loop = {0, 0, 1}) {
+    Skill::Skill skill = Skill::Skill::Empty();
+    skill.type = Skill::Type::Behaviour;
+    skill.frames = frames;
+    skill.loopSpec = loop;
+    skill.spec = spec.data();
+    skill.specLength = spec.size();
+    return skill;
+}
+
+// Steps without the attitude until the next move or the end, returning the move's frame or -1 when done.
+static int stepToNextMove(Skill::Behaviour& behaviour, uint32_t& nowUs) {
+    for (int tick = 0; tick < 1000; tick++) {
+        nowUs += 20000;
+        const Action action = behaviour.step(nowUs, false, 0.0f);
+        if (action == Action::Move) {
+            return behaviour.frame()[0];
+        } else if (action == Action::Done) {
+            return -1;
+        }
+    }
+    return -2;
+}
+
+TEST_CASE("Behaviour frames", "[Behaviour]" ) 
+{
+    Skill::Behaviour behaviour;
+    uint32_t nowUs = 0;
+
+    SECTION("only behaviours are played") {
+        std::vector<char> spec(DOF, 0);
+        Skill::Skill skill = behaviourSkill(spec, 1);
+        skill.type = Skill::Type::Posture;
+        behaviour.begin(skill);
+        REQUIRE_FALSE(behaviour.active());
+        REQUIRE(behaviour.step(0, false, 0.0f) == Action::None);
+    }
+
+    SECTION("moves in order then finishes") {
+        std::vector<char> spec = behaviourSpec({{8, 0, 0, 0}, {4, 0, 0, 0}, {12, 0, 0, 0}});
+        Skill::Skill skill = behaviourSkill(spec, 3);
+        behaviour.begin(skill);
+        REQUIRE(behaviour.active());
+        REQUIRE(behaviour.step(nowUs, false, 0.0f) == Action::Move);
+        REQUIRE(behaviour.frame()[0] == 0);
+        REQUIRE(behaviour.speedRatio() == 2.0f);
+        REQUIRE(stepToNextMove(behaviour, nowUs) == 1);
+        REQUIRE(behaviour.speedRatio() == 1.0f);
+        REQUIRE(stepToNextMove(behaviour, nowUs) == 2);
+        REQUIRE(stepToNextMove(behaviour, nowUs) == -1);
+        REQUIRE_FALSE(behaviour.active());
+    }
+
+    SECTION("waits for the move to finish") {
+        std::vector<char> spec = behaviourSpec({{4, 0, 0, 0}, {4, 0, 0, 0}});
+        Skill::Skill skill = behaviourSkill(spec, 2);
+        behaviour.begin(skill);
+        behaviour.step(nowUs, false, 0.0f);
+        for (int i = 0; i < 10; i++) {
+            REQUIRE(behaviour.step(nowUs, true, 0.0f) == Action::None);
+        }
+        REQUIRE(behaviour.step(nowUs, false, 0.0f) == Action::Move);
+        REQUIRE(behaviour.frameIndex() == 1);
+    }
+
+    SECTION("delays without blocking") {
+        std::vector<char> spec = behaviourSpec({{4, 3, 0, 0}, {4, 0, 0, 0}});
+        Skill::Skill skill = behaviourSkill(spec, 2);
+        behaviour.begin(skill);
+        behaviour.step(nowUs, false, 0.0f);
+        REQUIRE(behaviour.step(nowUs, false, 0.0f) == Action::None);
+        REQUIRE(behaviour.step(nowUs + 3 * BEHAVIOUR_DELAY_UNIT_US - 1, false, 0.0f) == Action::None);
+        REQUIRE(behaviour.step(nowUs + 3 * BEHAVIOUR_DELAY_UNIT_US, false, 0.0f) == Action::Move);
+    }
+
+    SECTION("abort") {
+        std::vector<char> spec = behaviourSpec({{4, 3, 0, 0}, {4, 0, 0, 0}});
+        Skill::Skill skill = behaviourSkill(spec, 2);
+        behaviour.begin(skill);
+        behaviour.step(nowUs, false, 0.0f);
+        behaviour.abort();
+        REQUIRE_FALSE(behaviour.active());
+        REQUIRE(behaviour.step(nowUs + 10 * BEHAVIOUR_DELAY_UNIT_US, false, 0.0f) == Action::None);
+    }
+}
+
+TEST_CASE("Behaviour loops", "[Behaviour]" ) 
+{
+    Skill::Behaviour behaviour;
+    uint32_t nowUs = 0;
+    std::vector<char> spec = behaviourSpec({{4, 0, 0, 0}, {4, 0, 0, 0}, {4, 0, 0, 0}, {4, 0, 0, 0}});
+    Skill::Skill skill = behaviourSkill(spec, 4, {1, 2, 3});
+    behaviour.begin(skill);
+
+    std::vector<int> frames;
+    REQUIRE(behaviour.step(nowUs, false, 0.0f) == Action::Move);
+    frames.push_back(behaviour.frame()[0]);
+    int frame = 0;
+    while ((frame = stepToNextMove(behaviour, nowUs)) >= 0) {
+        frames.push_back(frame);
+    }
+    REQUIRE(frame == -1);
+    REQUIRE(frames == std::vector<int>({0, 1, 2, 1, 2, 1, 2, 3}));
+}
+
+TEST_CASE("Behaviour triggers", "[Behaviour]" ) 
+{
+    Skill::Behaviour behaviour;
+    uint32_t nowUs = 0;
+    // Wait for pitch to fall through 30 degrees, or rise through -30 degrees.
+    std::vector<char> spec = behaviourSpec({{4, 0, 2, 30}, {4, 0, -2, -30}, {4, 0, 0, 0}});
+    Skill::Skill skill = behaviourSkill(spec, 3);
+    behaviour.begin(skill);
+    behaviour.step(nowUs, false, 0.0f);
+    REQUIRE(behaviour.triggerAxis() == 2);
+
+    SECTION("trigger on crossing") {
+        REQUIRE(behaviour.step(nowUs, false, 50 * M_DEG2RAD) == Action::None);
+        REQUIRE(behaviour.step(nowUs, false, 40 * M_DEG2RAD) == Action::None);
+        REQUIRE(behaviour.step(nowUs, false, 20 * M_DEG2RAD) == Action::Move);
+        REQUIRE(behaviour.triggerAxis() == -2);
+
+        REQUIRE(behaviour.step(nowUs, false, -50 * M_DEG2RAD) == Action::None);
+        REQUIRE(behaviour.step(nowUs, false, -40 * M_DEG2RAD) == Action::None);
+        REQUIRE(behaviour.step(nowUs, false, -20 * M_DEG2RAD) == Action::Move);
+        REQUIRE(behaviour.timeouts() == 0);
+    }
+
+    SECTION("wrong direction does not trigger") {
+        REQUIRE(behaviour.step(nowUs, false, 20 * M_DEG2RAD) == Action::None);
+        REQUIRE(behaviour.step(nowUs, false, 40 * M_DEG2RAD) == Action::None);
+    }
+
+    SECTION("jump from 180 to -180 does not trigger") {
+        REQUIRE(behaviour.step(nowUs, false, 179 * M_DEG2RAD) == Action::None);
+        REQUIRE(behaviour.step(nowUs, false, -179 * M_DEG2RAD) == Action::None);
+    }
+
+    SECTION("times out") {
+        REQUIRE(behaviour.step(nowUs, false, 0.0f) == Action::None);
+        REQUIRE(behaviour.step(nowUs + BEHAVIOUR_TRIGGER_TIMEOUT_US - 1, false, 0.0f) == Action::None);
+        REQUIRE(behaviour.step(nowUs + BEHAVIOUR_TRIGGER_TIMEOUT_US, false, 0.0f) == Action::Move);
+        REQUIRE(behaviour.timeouts() == 1);
+    }
+}
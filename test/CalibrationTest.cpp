@@ -0,0 +1,171 @@
+//
+// Servo Calibration Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+
+#include "servo/Calibration.h"
+
+#define DUTY_MIN (720)
+#define DUTY_MAX (2480)
+
+static void setupEeprom() {
+    EEPROM = EEPROMMock();
+    for (uint8_t i = 0; i < DOF; i++) {
+        EEPROM.data[PIN + i] = DOF - 1 - i;
+        EEPROM.data[CALIB + i] = (int8_t)(i - 8);
+        EEPROM.data[MID_SHIFT + i] = (i % 3 == 0) ? 45 : -10;
+        EEPROM.data[ROTATION_DIRECTION + i] = (i % 2 == 0) ? 1 : -1;
+        EEPROM.data[SERVO_ANGLE_RANGE + i] = (int8_t)(uint8_t)((i < 4) ? 180 : 250);
+        EEPROM.data[ADAPT_PARAM + i * NUM_ADAPT_PARAM] = (int8_t)(i * 3);
+        EEPROM.data[ADAPT_PARAM + i * NUM_ADAPT_PARAM + 1] = (int8_t)(-i);
+    }
+}
+
+// How calibratedPWM worked out duties from the EEPROM before the calibration was held in RAM
+static int16_t eepromDuty(uint8_t i, float angle) {
+    const float pulsePerDegree = float(DUTY_MAX - DUTY_MIN) / (uint8_t)EEPROM.read(SERVO_ANGLE_RANGE + i);
+    const int8_t direction = EEPROM.read(ROTATION_DIRECTION + i);
+    const int16_t duty0 = DUTY_MIN + (DUTY_MAX - DUTY_MIN) / 2 + float((int8_t)EEPROM.read(MID_SHIFT + i) + (int8_t)EEPROM.read(CALIB + i)) * pulsePerDegree * direction;
+    int duty = duty0 + angle * pulsePerDegree * direction;
+    return (duty < DUTY_MIN) ? DUTY_MIN : ((duty > DUTY_MAX) ? DUTY_MAX : duty);
+}
+
+TEST_CASE("Calibration::load", "[Calibration]" ) 
+{
+    setupEeprom();
+    Servo::Calibration calibration(DUTY_MIN, DUTY_MAX);
+    calibration.load();
+
+    for (uint8_t i = 0; i < DOF; i++) {
+        const Servo::Joint& joint = calibration.joint(i);
+        REQUIRE(joint.pin == DOF - 1 - i);
+        REQUIRE(joint.calib == i - 8);
+        REQUIRE(joint.middleShift == ((i % 3 == 0) ? 45 : -10));
+        REQUIRE(joint.direction == ((i % 2 == 0) ? 1 : -1));
+        REQUIRE(joint.adaptive[0] == (int8_t)(i * 3));
+        REQUIRE(joint.adaptive[1] == (int8_t)(-i));
+    }
+}
+
+TEST_CASE("Calibration::duty", "[Calibration]" ) 
+{
+    setupEeprom();
+    Servo::Calibration calibration(DUTY_MIN, DUTY_MAX);
+    calibration.load();
+
+    SECTION("matches the EEPROM computation") {
+        for (uint8_t i = 0; i < DOF; i++) {
+            for (float angle = -130.0f; angle <= 130.0f; angle += 0.75f) {
+                REQUIRE(calibration.duty(i, angle) == eepromDuty(i, angle));
+            }
+        }
+    }
+
+    SECTION("clamped to the servo limits") {
+        REQUIRE(calibration.duty(0, 1000.0f) == DUTY_MAX);
+        REQUIRE(calibration.duty(0, -1000.0f) == DUTY_MIN);
+        REQUIRE(calibration.duty(0, Servo::Angle(500.0f)) == DUTY_MAX);
+        REQUIRE(calibration.duty(0, Servo::Angle(-500.0f)) == DUTY_MIN);
+    }
+
+    SECTION("no angle range holds the middle") {
+        EEPROM.data[SERVO_ANGLE_RANGE + 3] = 0;
+        calibration.load();
+        REQUIRE(calibration.duty(3, 45.0f) == calibration.duty(3, -45.0f));
+        REQUIRE(calibration.duty(3, Servo::Angle(45.0f)) == calibration.duty(3, Servo::Angle(-45.0f)));
+    }
+
+    SECTION("fixed point within one count of float") {
+        for (uint8_t i = 0; i < DOF; i++) {
+            int16_t maxError = 0;
+            for (int16_t raw = -300 << SERVO_ANGLE_BITS; raw <= 300 << SERVO_ANGLE_BITS; raw++) {
+                const Servo::Angle angle = Servo::Angle::fromRaw(raw);
+                const int16_t error = abs(calibration.duty(i, angle) - calibration.duty(i, angle.toF32()));
+                maxError = (error > maxError) ? error : maxError;
+            }
+            REQUIRE(maxError <= 1);
+        }
+    }
+}
+
+TEST_CASE("Calibration::setCalib", "[Calibration]" ) 
+{
+    setupEeprom();
+    Servo::Calibration calibration(DUTY_MIN, DUTY_MAX);
+    calibration.load();
+
+    SECTION("applies immediately without writing") {
+        calibration.setCalib(5, 12);
+        REQUIRE(EEPROM.writes == 0);
+        EEPROM.data[CALIB + 5] = 12;
+        REQUIRE(calibration.duty(5, 30.0f) == eepromDuty(5, 30.0f));
+    }
+
+    SECTION("save writes only changed offsets") {
+        calibration.setCalib(5, 12);
+        calibration.setCalib(6, calibration.joint(6).calib);
+        calibration.save();
+        REQUIRE(EEPROM.writes == 1);
+        REQUIRE(EEPROM.data[CALIB + 5] == 12);
+    }
+
+    SECTION("load discards unsaved offsets") {
+        calibration.setCalib(5, 12);
+        calibration.load();
+        REQUIRE(calibration.joint(5).calib == -3);
+    }
+}
+
+TEST_CASE("Calibration::duty benchmark", "[.][benchmark]" ) 
+{
+    setupEeprom();
+    Servo::Calibration calibration(DUTY_MIN, DUTY_MAX);
+    calibration.load();
+
+    const uint16_t repeats = 200;
+    std::vector<float> anglesF;
+    std::vector<Servo::Angle> anglesQ;
+    for (float angle = -120.0f; angle <= 120.0f; angle += 0.25f) {
+        anglesF.push_back(angle);
+        anglesQ.push_back(Servo::Angle(angle));
+    }
+    const uint32_t duties = repeats * anglesF.size() * DOF;
+
+    typedef std::chrono::steady_clock Clock;
+    volatile int32_t sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for (uint16_t r = 0; r < repeats; r++) {
+        for (size_t a = 0; a < anglesF.size(); a++) {
+            for (uint8_t i = 0; i < DOF; i++) {
+                sink = sink + calibration.duty(i, anglesF[a]);
+            }
+        }
+    }
+    const double floatNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / duties;
+
+    start = Clock::now();
+    for (uint16_t r = 0; r < repeats; r++) {
+        for (size_t a = 0; a < anglesQ.size(); a++) {
+            for (uint8_t i = 0; i < DOF; i++) {
+                sink = sink + calibration.duty(i, anglesQ[a]);
+            }
+        }
+    }
+    const double fixedNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / duties;
+
+    std::cout << "Calibration::duty float: " << floatNs << " ns, fixed: " << fixedNs << " ns, speedup: " << floatNs / fixedNs << "x" << std::endl;
+    std::cout << "(host has an FPU, the AVR uses soft-float so the gap there is far larger)" << std::endl;
+}
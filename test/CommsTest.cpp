@@ -14,6 +14,7 @@
 
 #include "ui/Comms.h"
 #include "command/Command.h"
+#include "skill/Table.h"
 #include "Bittle.h"
 
 using namespace Comms;
@@ -263,6 +264,38 @@ TEST_CASE("ParseSerial_WithArgsSimple", "[Comms]" )
     }
 }
 
+TEST_CASE("ParseSerial_WithArgs_Sequence", "[Comms]" ) 
+{
+    struct TestCase {
+        std::string name;
+        std::string bytes;
+        Command::Command expected;
+    };
+
+    const ArgType type = ArgType::Sequence;
+    const int8_t sit = Skill::slot(Simple::Sit);
+    const int8_t walk = Skill::slot(Move{Pace::Medium, Direction::Forward});
+    const std::vector<TestCase> testCases = {
+        { "{}",                 "q\n",                     Command::Command(WithArgs{type, 0, {}})},
+        { "Names to slots",     "qwkF 2, sit -15\n",       Command::Command(WithArgs{type, 4, {walk, 2, sit, -15}})},
+        { "Expected in pairs",  "qwkF 2 sit\n",            Command::Command(WithArgs{type, 2, {walk, 2}})},
+        { "Unknown name",       "qwkF 2 sat 1\n",          Command::Command()},
+        { "Slot number",        "q21 1\n",                 Command::Command()},
+        { "Unknown last name",  "qwkF 2 sat\n",            Command::Command()},
+    };
+
+    const Move move = Move{Pace::Medium, Direction::Forward};
+    const int16_t currentPos[DOF] = {};
+
+    for (auto& tc : testCases) {
+        SECTION(tc.name) {
+            SerialComms comms{};
+            Serial = Stream(tc.bytes);
+            REQUIRE(tc.expected == comms.parse(move, currentPos));
+        }
+    }
+}
+
 TEST_CASE("ParseSerial_WithArgs_MoveSimultaneously", "[Comms]" ) 
 {
     struct TestCase {
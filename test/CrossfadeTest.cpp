@@ -0,0 +1,176 @@
+//
+// Gait Crossfade Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+
+#include "skill/Crossfade.h"
+
+// Every joint in a frame is set to base + frame number, so frames can be told apart.
+static std::vector<char> gaitSpec(uint8_t frames, int8_t base) {
+    std::vector<char> spec;
+    for (uint8_t f = 0; f < frames; f++) {
+        for (uint8_t i = 0; i < WALKING_DOF; i++) {
+            spec.push_back((char)(base + f));
+        }
+    }
+    return spec;
+}
+
+static Skill::Skill gaitSkill(std::vector<char>& spec, uint8_t frames, bool doubleAngles = false) {
+    Skill::Skill skill = Skill::Skill::Empty();
+    skill.type = Skill::Type::Gait;
+    skill.frames = frames;
+    skill.doubleAngles = doubleAngles;
+    skill.spec = spec.data();
+    skill.specLength = spec.size();
+    return skill;
+}
+
+static void requireAngles(const Servo::Angle* angles, float expected) {
+    for (uint8_t i = 0; i < WALKING_DOF; i++) {
+        REQUIRE(angles[i].toF32() == Approx(expected).margin(1.0 / 64));
+    }
+}
+
+TEST_CASE("Crossfade phase alignment", "[Crossfade]" ) 
+{
+    Skill::Crossfade crossfade;
+    auto walkSpec = gaitSpec(8, 0);
+    const Skill::Skill walk = gaitSkill(walkSpec, 8);
+    Servo::Angle angles[WALKING_DOF];
+
+    SECTION("same point in the cycle") {
+        crossfade.begin(walk, 4);
+        REQUIRE(crossfade.alignedFrame(8) == 4);
+        REQUIRE(crossfade.alignedFrame(16) == 8);
+        REQUIRE(crossfade.alignedFrame(4) == 2);
+    }
+
+    SECTION("follows the old gait while it is held") {
+        crossfade.begin(walk, 4);
+        crossfade.hold(angles);
+        crossfade.hold(angles);
+        REQUIRE(crossfade.alignedFrame(16) == 12);
+    }
+
+    SECTION("wraps at the end of the cycle") {
+        crossfade.begin(walk, 7);
+        crossfade.hold(angles);
+        REQUIRE(crossfade.alignedFrame(8) == 0);
+        REQUIRE(crossfade.alignedFrame(16) == 0);
+    }
+
+    SECTION("rounds to the nearest frame") {
+        crossfade.begin(walk, 3);
+        REQUIRE(crossfade.alignedFrame(5) == 2);
+    }
+}
+
+TEST_CASE("Crossfade hold", "[Crossfade]" ) 
+{
+    Skill::Crossfade crossfade;
+    auto walkSpec = gaitSpec(8, 10);
+    const Skill::Skill walk = gaitSkill(walkSpec, 8);
+    Servo::Angle angles[WALKING_DOF];
+
+    SECTION("keeps playing the old gait from where it was") {
+        crossfade.begin(walk, 6);
+        crossfade.hold(angles);
+        requireAngles(angles, 16);
+        crossfade.hold(angles);
+        requireAngles(angles, 17);
+        crossfade.hold(angles);
+        requireAngles(angles, 10);
+        REQUIRE(crossfade.active());
+    }
+
+    SECTION("holds the last frame kept if loading takes too long") {
+        crossfade.begin(walk, 0);
+        for (uint8_t f = 0; f < CROSSFADE_FRAMES + 3; f++) {
+            crossfade.hold(angles);
+        }
+        requireAngles(angles, 10 + CROSSFADE_FRAMES - 1);
+    }
+
+    SECTION("frames are copied, so the old gait can be unloaded") {
+        crossfade.begin(walk, 0);
+        for (char& c : walkSpec) {
+            c = 0;
+        }
+        crossfade.hold(angles);
+        requireAngles(angles, 10);
+    }
+
+    SECTION("double angles are applied to the old gait") {
+        const Skill::Skill doubled = gaitSkill(walkSpec, 8, true);
+        crossfade.begin(doubled, 0);
+        crossfade.hold(angles);
+        requireAngles(angles, 20);
+    }
+}
+
+TEST_CASE("Crossfade step", "[Crossfade]" ) 
+{
+    Skill::Crossfade crossfade;
+    auto walkSpec = gaitSpec(8, 0);
+    auto trotSpec = gaitSpec(4, 40);
+    const Skill::Skill walk = gaitSkill(walkSpec, 8);
+    const Skill::Skill trot = gaitSkill(trotSpec, 4);
+    Servo::Angle angles[WALKING_DOF];
+
+    SECTION("inactive until begun") {
+        REQUIRE_FALSE(crossfade.active());
+        REQUIRE_FALSE(crossfade.step(trot, 0, angles));
+    }
+
+    SECTION("only gaits are faded from") {
+        auto postureSpec = gaitSpec(1, 0);
+        Skill::Skill posture = gaitSkill(postureSpec, 1);
+        posture.type = Skill::Type::Posture;
+        crossfade.begin(posture, 0);
+        REQUIRE_FALSE(crossfade.active());
+    }
+
+    SECTION("moves monotonically from the old gait to the new one") {
+        crossfade.begin(walk, 0);
+        float last = 0;
+        for (uint8_t s = 0; s < CROSSFADE_STEPS; s++) {
+            REQUIRE(crossfade.step(trot, 0, angles));
+            REQUIRE(angles[0].toF32() > last);
+            last = angles[0].toF32();
+        }
+        requireAngles(angles, 40);
+        REQUIRE_FALSE(crossfade.active());
+        REQUIRE_FALSE(crossfade.step(trot, 0, angles));
+    }
+
+    SECTION("first step is mostly the old gait") {
+        crossfade.begin(walk, 0);
+        crossfade.step(trot, 0, angles);
+        REQUIRE(angles[0].toF32() < 20);
+    }
+
+    SECTION("new gait frames and double angles are used") {
+        const Skill::Skill doubled = gaitSkill(trotSpec, 4, true);
+        crossfade.begin(walk, 0);
+        for (uint8_t s = 0; s < CROSSFADE_STEPS; s++) {
+            crossfade.step(doubled, 2, angles);
+        }
+        requireAngles(angles, 84);
+    }
+
+    SECTION("stop ends the fade") {
+        crossfade.begin(walk, 0);
+        crossfade.stop();
+        REQUIRE_FALSE(crossfade.active());
+    }
+}
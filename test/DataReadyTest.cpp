@@ -0,0 +1,155 @@
+//
+// IMU Data Ready Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+
+#include "state/DataReady.h"
+#include "state/ImuFifo.h"
+
+#define TEST_INTERRUPT (0)
+
+static void pushSample(std::vector<uint8_t>& bytes) {
+    for (uint8_t i = 0; i < IMU_FIFO_SAMPLE_BYTES; i++) {
+        bytes.push_back(0);
+    }
+}
+
+TEST_CASE("DataReady ring", "[DataReady]" ) 
+{
+    Attitude::DataReady ready;
+    uint32_t us = 0;
+
+    SECTION("empty until captured") {
+        REQUIRE(ready.size() == 0);
+        REQUIRE_FALSE(ready.pop(us));
+    }
+
+    SECTION("stamps come out in capture order") {
+        ready.capture(100);
+        ready.capture(200);
+        REQUIRE(ready.size() == 2);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 100);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 200);
+        REQUIRE_FALSE(ready.pop(us));
+    }
+
+    SECTION("wraps around the ring") {
+        for (uint32_t i = 0; i < 3 * DATA_READY_SIZE; i++) {
+            ready.capture(i);
+            REQUIRE(ready.pop(us));
+            REQUIRE(us == i);
+        }
+        REQUIRE(ready.overflows() == 0);
+    }
+
+    SECTION("a full ring drops and counts the newest stamps") {
+        for (uint32_t i = 0; i < DATA_READY_SIZE + 2; i++) {
+            ready.capture(i);
+        }
+        REQUIRE(ready.size() == DATA_READY_SIZE);
+        REQUIRE(ready.overflows() == 2);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 0);
+    }
+
+    SECTION("clear drops what was captured") {
+        ready.capture(100);
+        ready.clear();
+        REQUIRE_FALSE(ready.pop(us));
+        ready.capture(200);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 200);
+    }
+}
+
+TEST_CASE("DataReady interrupt", "[DataReady]" ) 
+{
+    TimeMock::reset();
+    InterruptMock::reset();
+    Attitude::DataReady ready;
+    ready.attach(TEST_INTERRUPT);
+    uint32_t us = 0;
+
+    SECTION("attaches on the rising edge") {
+        REQUIRE(InterruptMock::modes[TEST_INTERRUPT] == RISING);
+    }
+
+    SECTION("wait for next drops old stamps and returns after a capture") {
+        ready.capture(100);
+        TimeMock::currentUs = 1000;
+        InterruptMock::schedule(TEST_INTERRUPT, 3000);
+        REQUIRE(ready.waitForNext(10000));
+        REQUIRE(TimeMock::currentUs == 3000);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 3000);
+        REQUIRE_FALSE(ready.pop(us));
+    }
+
+    SECTION("wait for next works from a full ring") {
+        for (uint8_t i = 0; i < DATA_READY_SIZE; i++) {
+            ready.capture(i);
+        }
+        InterruptMock::schedule(TEST_INTERRUPT, 500);
+        REQUIRE(ready.waitForNext(10000));
+        REQUIRE(ready.size() == 1);
+    }
+
+    SECTION("wait for next gives up without an interrupt") {
+        REQUIRE_FALSE(ready.waitForNext(10000));
+        REQUIRE(TimeMock::currentUs == 10000);
+    }
+
+    SECTION("stamps each interrupt with the time it fired") {
+        TimeMock::currentUs = 1234;
+        InterruptMock::trigger(TEST_INTERRUPT);
+        TimeMock::currentUs = 6250;
+        InterruptMock::trigger(TEST_INTERRUPT);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 1234);
+        REQUIRE(ready.pop(us));
+        REQUIRE(us == 6250);
+    }
+
+    SECTION("samples read late keep the time they were taken") {
+        Attitude::ImuFifo fifo;
+        std::vector<uint8_t> bytes;
+        pushSample(bytes);
+        pushSample(bytes);
+        Attitude::Measurement out[IMU_FIFO_BATCH];
+
+        TimeMock::currentUs = 10000;
+        InterruptMock::trigger(TEST_INTERRUPT);
+        TimeMock::currentUs = 15100;
+        InterruptMock::trigger(TEST_INTERRUPT);
+
+        fifo.decode(bytes.data(), 2, 23000, out, &ready); // The attitude task ran late
+        REQUIRE(out[0].us == 10000);
+        REQUIRE(out[1].us == 15100);
+    }
+
+    SECTION("samples without a stamp fall back to the sample period") {
+        Attitude::ImuFifo fifo;
+        std::vector<uint8_t> bytes;
+        pushSample(bytes);
+        pushSample(bytes);
+        Attitude::Measurement out[IMU_FIFO_BATCH];
+
+        TimeMock::currentUs = 10000;
+        InterruptMock::trigger(TEST_INTERRUPT);
+
+        fifo.decode(bytes.data(), 2, 16000, out, &ready);
+        REQUIRE(out[0].us == 10000);
+        REQUIRE(out[1].us == 10000 + IMU_SAMPLE_PERIOD_US);
+    }
+}
@@ -0,0 +1,116 @@
+//
+// Skill Delta Coding Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include "Arduino.h"
+
+#include "skill/Delta.h"
+
+static std::vector<char> roundTrip(const std::vector<char>& spec, uint8_t frameSize, uint16_t pieceSize, uint16_t& packedLength) {
+    std::vector<char> packed(spec.size() * 2 + 16);
+    packedLength = Skill::deltaEncode(spec.data(), spec.size(), frameSize, packed.data(), packed.size());
+    REQUIRE(packedLength > 0);
+
+    std::vector<char> decoded(spec.size(), 0x55);
+    Skill::DeltaDecoder decoder;
+    decoder.begin(decoded.data(), decoded.size(), frameSize);
+    uint16_t used = 0;
+    while (used < packedLength) {
+        const uint16_t piece = std::min<uint16_t>(pieceSize, packedLength - used);
+        REQUIRE(decoder.decode(packed.data() + used, piece) == piece);
+        used += piece;
+    }
+    REQUIRE(decoder.done());
+    REQUIRE(decoder.decoded() == spec.size());
+    return decoded;
+}
+
+// Joint angles which move smoothly, like a gait cycle
+static std::vector<char> smoothFrames(uint8_t frames, uint8_t frameSize) {
+    std::vector<char> spec;
+    for (uint8_t f = 0; f < frames; f++) {
+        for (uint8_t j = 0; j < frameSize; j++) {
+            spec.push_back((char)(int8_t)(40.0 * std::sin(2.0 * M_PI * f / frames + j) + 10 * j % 30));
+        }
+    }
+    return spec;
+}
+
+TEST_CASE("Delta coding - round trip", "[Delta]" ) 
+{
+    uint16_t packedLength = 0;
+
+    SECTION("smooth frames") {
+        const std::vector<char> spec = smoothFrames(40, 8);
+        REQUIRE(roundTrip(spec, 8, 1000, packedLength) == spec);
+        REQUIRE(packedLength < spec.size() * 3 / 4);
+    }
+
+    SECTION("decoded in single bytes") {
+        const std::vector<char> spec = smoothFrames(20, 16);
+        REQUIRE(roundTrip(spec, 16, 1, packedLength) == spec);
+    }
+
+    SECTION("repeated frames") {
+        const std::vector<char> spec(200, 12);
+        REQUIRE(roundTrip(spec, 20, 7, packedLength) == spec);
+        REQUIRE(packedLength <= spec.size() / 2 + 20);
+    }
+
+    SECTION("random data") {
+        std::srand(1234);
+        std::vector<char> spec;
+        for (int i = 0; i < 500; i++) {
+            spec.push_back((char)(std::rand() & 0xFF));
+        }
+        REQUIRE(roundTrip(spec, 8, 5, packedLength) == spec);
+
+        std::vector<char> packed(spec.size());
+        REQUIRE(Skill::deltaEncode(spec.data(), spec.size(), 8, packed.data(), spec.size() - 1) == 0);
+    }
+
+    SECTION("every difference") {
+        std::vector<char> spec;
+        for (int d = -128; d < 128; d++) {
+            spec.push_back((char)(spec.empty() ? 0 : spec.back() + d));
+        }
+        REQUIRE(roundTrip(spec, 1, 3, packedLength) == spec);
+    }
+
+    SECTION("extremes") {
+        const std::vector<char> spec = {-128, 127, -128, 127, 0, 0, 0, -1, 1, -4, 3, -32, 31, -33, 32};
+        REQUIRE(roundTrip(spec, 3, 2, packedLength) == spec);
+    }
+}
+
+TEST_CASE("Delta coding - limits", "[Delta]" ) 
+{
+    const std::vector<char> spec = smoothFrames(10, 8);
+
+    SECTION("encoding fails when the output is too small") {
+        char packed[4];
+        REQUIRE(Skill::deltaEncode(spec.data(), spec.size(), 8, packed, sizeof(packed)) == 0);
+    }
+
+    SECTION("decoder stops at the output length") {
+        std::vector<char> packed(spec.size() * 2);
+        const uint16_t packedLength = Skill::deltaEncode(spec.data(), spec.size(), 8, packed.data(), packed.size());
+        packed[packedLength] = 0x3F; // 64 more zeros which must not be written
+
+        std::vector<char> decoded(spec.size() + 1, 0x55);
+        Skill::DeltaDecoder decoder;
+        decoder.begin(decoded.data(), spec.size(), 8);
+        REQUIRE(decoder.decode(packed.data(), packedLength + 1) == packedLength);
+        REQUIRE(decoded.back() == 0x55);
+    }
+}
@@ -0,0 +1,131 @@
+//
+// DMP Attitude Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+#include "Helpers.h"
+
+#include <vector>
+
+#include "Arduino.h"
+
+#include "state/Dmp.h"
+#include "state/Attitude.h"
+#include "math/Trig.h"
+
+#define NOMINAL_G (16384)
+
+using Quaternion = Attitude::Quaternion;
+
+static Quaternion aboutX(float angle) { return Quaternion{cosf(angle / 2), sinf(angle / 2), 0, 0}; }
+static Quaternion aboutY(float angle) { return Quaternion{cosf(angle / 2), 0, sinf(angle / 2), 0}; }
+static Quaternion aboutZ(float angle) { return Quaternion{cosf(angle / 2), 0, 0, sinf(angle / 2)}; }
+
+static Quaternion multiply(const Quaternion& a, const Quaternion& b) {
+    return Quaternion{
+        a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+        a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+        a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+        a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+    };
+}
+
+TEST_CASE("Quaternion::fromPacket", "[Dmp]" ) 
+{
+    // Only the top two bytes of each word are used
+    const uint8_t packet[16] = {
+        0x40, 0x00, 0x12, 0x34,
+        0xC0, 0x00, 0x00, 0x00,
+        0x20, 0x00, 0xFF, 0xFF,
+        0x00, 0x00, 0x00, 0x01,
+    };
+    const Quaternion q = Quaternion::fromPacket(packet);
+    REQUIRE(q.w == 1.0f);
+    REQUIRE(q.x == -1.0f);
+    REQUIRE(q.y == 0.5f);
+    REQUIRE(q.z == 0.0f);
+}
+
+TEST_CASE("Dmp::update", "[Dmp]" ) 
+{
+    Attitude::Dmp dmp;
+
+    SECTION("level") {
+        dmp.update(Quaternion{1, 0, 0, 0});
+        NEAR(0.0f, dmp.roll(), 1e-6);
+        NEAR(0.0f, dmp.pitch(), 1e-6);
+        NEAR(0.0f, dmp.yaw(), 1e-6);
+    }
+
+    SECTION("single axes") {
+        // Past a right angle the other axis reads pi, as it does for the complementary filter
+        for (float angle : {-1.5f, -1.0f, -0.3f, 0.3f, 1.0f, 1.5f}) {
+            dmp.update(aboutX(angle));
+            NEAR(angle, dmp.angleFromAxis(Attitude::Axis::Roll), 1e-5);
+            NEAR(0.0f, dmp.angleFromAxis(Attitude::Axis::Pitch), 1e-5);
+
+            dmp.update(aboutY(angle));
+            NEAR(0.0f, dmp.angleFromAxis(Attitude::Axis::Roll), 1e-5);
+            NEAR(angle, dmp.angleFromAxis(Attitude::Axis::Pitch), 1e-5);
+
+            dmp.update(aboutZ(angle));
+            NEAR(angle, dmp.angleFromAxis(Attitude::Axis::Yaw), 1e-5);
+            NEAR(0.0f, dmp.roll(), 1e-5);
+            NEAR(0.0f, dmp.pitch(), 1e-5);
+        }
+    }
+
+    SECTION("heading does not change roll and pitch") {
+        dmp.update(multiply(aboutZ(1.2f), aboutX(0.4f)));
+        NEAR(0.4f, dmp.roll(), 1e-5);
+        NEAR(0.0f, dmp.pitch(), 1e-5);
+    }
+
+    SECTION("turned around negates roll and pitch") {
+        Attitude::Dmp turned(true);
+        const Quaternion q = multiply(aboutX(0.3f), aboutY(-0.2f));
+        dmp.update(q);
+        turned.update(q);
+        NEAR(-dmp.roll(), turned.roll(), 1e-6);
+        NEAR(-dmp.pitch(), turned.pitch(), 1e-6);
+    }
+
+    SECTION("reset") {
+        dmp.update(aboutX(1.0f));
+        dmp.reset();
+        REQUIRE(dmp.roll() == 0.0f);
+    }
+}
+
+TEST_CASE("Dmp agrees with the complementary filter at rest", "[Dmp]" ) 
+{
+    const std::vector<Quaternion> orientations = {
+        aboutX(0.5f),
+        aboutY(-0.7f),
+        multiply(aboutX(0.3f), aboutY(0.4f)),
+        multiply(aboutY(1.1f), aboutX(-0.6f)),
+        aboutX(M_PI),
+    };
+
+    for (auto& q : orientations) {
+        Attitude::Dmp dmp;
+        dmp.update(q);
+
+        // The accelerometer reads the gravity vector the DMP works out
+        const float gx = 2.0f * (q.x * q.z - q.w * q.y);
+        const float gy = 2.0f * (q.w * q.x + q.y * q.z);
+        const float gz = q.w * q.w - q.x * q.x - q.y * q.y + q.z * q.z;
+        Attitude::Attitude filter;
+        filter.update(Attitude::Measurement{.us = 0, .accel = Attitude::Vec3{
+            (int16_t)(gx * NOMINAL_G), (int16_t)(gy * NOMINAL_G), (int16_t)(gz * NOMINAL_G)}, .gyro = Attitude::Vec3{0, 0, 0}});
+
+        Attitude::Provider& a = dmp;
+        Attitude::Provider& b = filter;
+        NEAR(shortestRadianPath(a.roll(), b.roll()), 0.0f, 1e-3);
+        NEAR(shortestRadianPath(a.pitch(), b.pitch()), 0.0f, 1e-3);
+    }
+}
@@ -0,0 +1,64 @@
+//
+// Easing Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <math.h>
+
+#include "Arduino.h"
+
+#include "math/Easing.h"
+
+#define EASE_ONE (1 << EASE_BITS)
+#define PHASE_ONE (1 << EASE_PHASE_BITS)
+
+TEST_CASE("cosineEase", "[Easing]" ) 
+{
+    SECTION("end points") {
+        REQUIRE(cosineEase(0) == EASE_ONE);
+        REQUIRE(cosineEase(PHASE_ONE / 2) == EASE_ONE / 2);
+        REQUIRE(cosineEase(PHASE_ONE) == 0);
+        REQUIRE(cosineEase(0xffff) == 0);
+    }
+
+    SECTION("table entries match cos") {
+        for (int i = 0; i <= EASE_TABLE_SIZE; i++) {
+            const double expected = (1.0 + cos(M_PI * i / EASE_TABLE_SIZE)) / 2.0 * EASE_ONE;
+            REQUIRE(fabs(cosineEaseEntry(i) - expected) <= 0.5);
+        }
+    }
+
+    SECTION("every phase is within 3e-4 of cos") {
+        double maxError = 0.0;
+        for (uint32_t phase = 0; phase <= PHASE_ONE; phase++) {
+            const double expected = (1.0 + cos(M_PI * phase / PHASE_ONE)) / 2.0;
+            const double error = fabs((double)cosineEase(phase) / EASE_ONE - expected);
+            maxError = (error > maxError) ? error : maxError;
+        }
+        REQUIRE(maxError < 3e-4);
+    }
+
+    SECTION("monotonically falling") {
+        uint16_t last = cosineEase(0);
+        for (uint32_t phase = 1; phase <= PHASE_ONE; phase++) {
+            const uint16_t ease = cosineEase(phase);
+            REQUIRE(ease <= last);
+            last = ease;
+        }
+    }
+}
+
+TEST_CASE("easePhase", "[Easing]" ) 
+{
+    REQUIRE(easePhase(0, 10) == 0);
+    REQUIRE(easePhase(5, 10) == PHASE_ONE / 2);
+    REQUIRE(easePhase(10, 10) == PHASE_ONE);
+    REQUIRE(easePhase(1, 3) == PHASE_ONE / 3);
+    REQUIRE(easePhase(0, 0) == PHASE_ONE);
+    REQUIRE(easePhase(255, 255) == PHASE_ONE);
+}
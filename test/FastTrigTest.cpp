@@ -0,0 +1,224 @@
+//
+// Fast Trigonometry Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <math.h>
+#include <vector>
+
+#include "Arduino.h"
+#include "Helpers.h"
+
+#include "math/FastTrig.h"
+#include "math/Trig.h"
+
+#define ATAN2_BINARY_MAX_ERROR (1e-4)
+#define SIN_BINARY_MAX_ERROR (7e-5)
+#define ATAN2_MAX_ERROR (2e-5)
+#define SIN_MAX_ERROR (1e-6)
+
+// Error of an angle, ignoring whole turns
+static double angleError(double expected, double result) {
+    return fabs(remainder(result - expected, 2.0 * M_PI));
+}
+
+static double binaryToDouble(int64_t a) {
+    return (double)a * M_PI / 2147483648.0;
+}
+
+TEST_CASE("atan2Binary error bound", "[FastTrig]" )
+{
+    SECTION("every direction at full scale") {
+        double worst = 0.0;
+        for (int32_t i = -32768; i < 32768; i++) {
+            const double direction = i * M_PI / 32768.0;
+            const int32_t x = (int32_t)lround(cos(direction) * 65535.0);
+            const int32_t y = (int32_t)lround(sin(direction) * 65535.0);
+            const double error = angleError(atan2((double)y, (double)x), binaryToDouble(atan2Binary(y, x)));
+            worst = (error > worst) ? error : worst;
+        }
+        REQUIRE(worst < ATAN2_BINARY_MAX_ERROR);
+    }
+
+    SECTION("accelerometer range grid") {
+        double worst = 0.0;
+        for (int32_t x = -32768; x < 32768; x += 61) {
+            for (int32_t y = -32768; y < 32768; y += 67) {
+                const double error = angleError(atan2((double)y, (double)x), binaryToDouble(atan2Binary(y, x)));
+                worst = (error > worst) ? error : worst;
+            }
+        }
+        REQUIRE(worst < ATAN2_BINARY_MAX_ERROR);
+    }
+
+    SECTION("axes") {
+        REQUIRE(atan2Binary(0, 0) == 0);
+        REQUIRE(atan2Binary(0, 100) == 0);
+        REQUIRE(atan2Binary(100, 0) == BINARY_ANGLE_HALF_PI);
+        REQUIRE(atan2Binary(-100, 0) == -BINARY_ANGLE_HALF_PI);
+        REQUIRE(atan2Binary(0, -100) == (BinaryAngle)0x80000000UL);
+    }
+}
+
+TEST_CASE("sinBinary and cosBinary error bound", "[FastTrig]" )
+{
+    // Every 16 bit angle, which is finer than a Q15 result can tell apart
+    double worstSin = 0.0;
+    double worstCos = 0.0;
+    for (int64_t a = -2147483648LL; a < 2147483648LL; a += 0x10000) {
+        const double r = binaryToDouble(a);
+        const double sinError = fabs(sinBinary((BinaryAngle)a) / 32768.0 - sin(r));
+        const double cosError = fabs(cosBinary((BinaryAngle)a) / 32768.0 - cos(r));
+        worstSin = (sinError > worstSin) ? sinError : worstSin;
+        worstCos = (cosError > worstCos) ? cosError : worstCos;
+    }
+    REQUIRE(worstSin < SIN_BINARY_MAX_ERROR);
+    REQUIRE(worstCos < SIN_BINARY_MAX_ERROR);
+
+    SECTION("right angles") {
+        REQUIRE(sinBinary(0) == 0);
+        REQUIRE(sinBinary(BINARY_ANGLE_HALF_PI) == 32767);
+        REQUIRE(sinBinary(-BINARY_ANGLE_HALF_PI) == -32767);
+        REQUIRE(cosBinary(0) == 32767);
+        REQUIRE(cosBinary((BinaryAngle)0x80000000UL) == -32767);
+    }
+}
+
+TEST_CASE("fastAtan2 error bound", "[FastTrig]" )
+{
+    SECTION("every direction") {
+        double worst = 0.0;
+        for (int32_t i = -65536; i < 65536; i++) {
+            const double direction = i * M_PI / 65536.0;
+            const float x = (float)cos(direction);
+            const float y = (float)sin(direction);
+            const double error = angleError(atan2((double)y, (double)x), fastAtan2(y, x));
+            worst = (error > worst) ? error : worst;
+        }
+        REQUIRE(worst < ATAN2_MAX_ERROR);
+    }
+
+    SECTION("scale does not matter") {
+        for (float scale = 1e-3f; scale < 1e5f; scale *= 10.0f) {
+            NEAR(atan2(0.3, -0.7), fastAtan2(0.3f * scale, -0.7f * scale), ATAN2_MAX_ERROR);
+        }
+    }
+
+    SECTION("axes") {
+        REQUIRE(fastAtan2(0.0f, 0.0f) == 0.0f);
+        REQUIRE(fastAtan2(0.0f, 1.0f) == 0.0f);
+        NEAR(M_PI / 2.0, fastAtan2(1.0f, 0.0f), ATAN2_MAX_ERROR);
+        NEAR(-M_PI / 2.0, fastAtan2(-1.0f, 0.0f), ATAN2_MAX_ERROR);
+        NEAR(M_PI, fastAtan2(0.0f, -1.0f), ATAN2_MAX_ERROR);
+    }
+}
+
+TEST_CASE("fastSin and fastCos error bound", "[FastTrig]" )
+{
+    // Two turns either way, at every float step of 2^-16
+    double worstSin = 0.0;
+    double worstCos = 0.0;
+    for (int32_t i = -(int32_t)(4.0 * M_PI * 65536.0); i < (int32_t)(4.0 * M_PI * 65536.0); i++) {
+        const float r = (float)i / 65536.0f;
+        const double sinError = fabs(fastSin(r) - sin((double)r));
+        const double cosError = fabs(fastCos(r) - cos((double)r));
+        worstSin = (sinError > worstSin) ? sinError : worstSin;
+        worstCos = (cosError > worstCos) ? cosError : worstCos;
+    }
+    REQUIRE(worstSin < SIN_MAX_ERROR);
+    REQUIRE(worstCos < SIN_MAX_ERROR);
+}
+
+TEST_CASE("wrapPiToNegPi", "[Trig]" )
+{
+    SECTION("angles in range come back unchanged") {
+        for (float r = -3.14f; r < 3.14f; r += 0.01f) {
+            REQUIRE(wrapPiToNegPi(r) == r);
+        }
+        REQUIRE(wrapPiToNegPi((float)M_PI) == (float)M_PI);
+    }
+
+    SECTION("minus pi comes back as pi") {
+        REQUIRE(wrapPiToNegPi((float)-M_PI) == (float)M_PI);
+    }
+
+    SECTION("whole turns are removed in one step") {
+        for (int turns = -100; turns <= 100; turns++) {
+            const float r = 1.0f + turns * (float)(2.0 * M_PI);
+            NEAR(1.0, wrapPiToNegPi(r), 1e-6 * (abs(turns) + 1));
+        }
+    }
+
+    SECTION("always in range") {
+        for (float r = -50.0f; r < 50.0f; r += 0.001f) {
+            const float wrapped = wrapPiToNegPi(r);
+            REQUIRE(wrapped <= (float)M_PI);
+            REQUIRE(wrapped >= (float)-M_PI);
+        }
+    }
+}
+
+TEST_CASE("FastTrig benchmark", "[.][benchmark]" )
+{
+    const uint32_t count = 1000000;
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<BinaryAngle> angles;
+    for (uint32_t i = 0; i < count; i++) {
+        const double direction = i * 2.0 * M_PI / count - M_PI;
+        xs.push_back((float)cos(direction) * 16384.0f);
+        ys.push_back((float)sin(direction) * 16384.0f);
+        angles.push_back(radiansToBinaryAngle((float)direction));
+    }
+
+    typedef std::chrono::steady_clock Clock;
+    volatile float sinkF = 0.0f;
+    volatile int32_t sinkQ = 0;
+
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        sinkF = sinkF + atan2f(ys[i], xs[i]);
+    }
+    const double libmAtan2Ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        sinkF = sinkF + fastAtan2(ys[i], xs[i]);
+    }
+    const double fastAtan2Ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        sinkQ = sinkQ + atan2Binary((int32_t)ys[i], (int32_t)xs[i]);
+    }
+    const double binaryAtan2Ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        sinkF = sinkF + sinf(binaryAngleToRadians(angles[i]));
+    }
+    const double libmSinNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        sinkF = sinkF + fastSin(binaryAngleToRadians(angles[i]));
+    }
+    const double fastSinNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < count; i++) {
+        sinkQ = sinkQ + sinBinary(angles[i]);
+    }
+    const double binarySinNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / count;
+
+    std::cout << "atan2 libm: " << libmAtan2Ns << " ns, fast: " << fastAtan2Ns << " ns, binary: " << binaryAtan2Ns << " ns" << std::endl;
+    std::cout << "sin libm: " << libmSinNs << " ns, fast: " << fastSinNs << " ns, binary: " << binarySinNs << " ns" << std::endl;
+    std::cout << "(host has an FPU, the AVR uses soft-float so the gap there is far larger)" << std::endl;
+}
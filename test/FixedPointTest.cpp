@@ -0,0 +1,100 @@
+//
+// Fixed Point Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include "math/FixedPoint.h"
+
+typedef FixedPoint<int16_t, 8> Q8;
+typedef FixedPoint<int32_t, 16> Q16;
+
+TEST_CASE("FixedPoint conversions", "[FixedPoint]" ) 
+{
+    REQUIRE(Q8(1.5f).raw() == 384);
+    REQUIRE(Q8(-1.5f).toF32() == -1.5f);
+    REQUIRE(Q8::fromInt(-3).raw() == -768);
+    REQUIRE(Q8::fromRaw(1).toF32() == 1.0f / 256);
+    REQUIRE(Q16::fromInt(20000).toF32() == 20000.0f);
+
+    SECTION("floor rounds down") {
+        REQUIRE(Q8(2.75f).floor() == 2);
+        REQUIRE(Q8(-2.75f).floor() == -3);
+        REQUIRE(Q8(-3.0f).floor() == -3);
+    }
+
+    SECTION("truncate rounds towards zero") {
+        for (float v = -100.0f; v < 100.0f; v += 0.125f) {
+            REQUIRE(Q8(v).truncate() == (int16_t)v);
+        }
+    }
+
+    SECTION("rounding holds at the ends of the range") {
+        typedef FixedPoint<int16_t, 0> Q0;
+        typedef FixedPoint<int32_t, 4> Q4;
+        REQUIRE(Q0::fromRaw(INT16_MIN).truncate() == INT16_MIN);
+        REQUIRE(Q0::fromRaw(INT16_MIN).floor() == INT16_MIN);
+        REQUIRE(Q0::fromRaw(INT16_MAX).truncate() == INT16_MAX);
+        REQUIRE(Q16::fromRaw(INT32_MIN).truncate() == -32768);
+        REQUIRE(Q16::fromRaw(INT32_MAX).truncate() == 32767);
+        REQUIRE(Q4::fromRaw(INT32_MIN).truncate() == INT16_MIN);
+        REQUIRE(Q4::fromRaw(INT32_MAX).floor() == INT16_MAX);
+    }
+}
+
+TEST_CASE("FixedPoint arithmetic", "[FixedPoint]" ) 
+{
+    SECTION("add and subtract") {
+        REQUIRE((Q8(1.25f) + Q8(2.5f)).toF32() == 3.75f);
+        REQUIRE((Q8(1.25f) - Q8(2.5f)).toF32() == -1.25f);
+        REQUIRE((-Q8(1.25f)).toF32() == -1.25f);
+        Q8 v(1.0f);
+        v += Q8(0.5f);
+        v -= Q8(2.0f);
+        REQUIRE(v.toF32() == -0.5f);
+    }
+
+    SECTION("multiply does not overflow before shifting") {
+        REQUIRE((Q8(100.0f) * Q8(0.25f)).toF32() == 25.0f);
+        REQUIRE((Q8(-12.5f) * Q8(4.0f)).toF32() == -50.0f);
+        REQUIRE((Q16(300.0f) * Q16(-100.0f)).toF32() == -30000.0f);
+        REQUIRE((Q8(1.5f) * -3).toF32() == -4.5f);
+    }
+
+    SECTION("int multiply saturates") {
+        REQUIRE((Q8(100.0f) * 2).raw() == INT16_MAX);
+        REQUIRE((Q8(100.0f) * -2).raw() == INT16_MIN);
+        REQUIRE((Q8(-100.0f) * 300).raw() == INT16_MIN);
+        REQUIRE((Q16(30000.0f) * 3).raw() == INT32_MAX);
+        REQUIRE((Q8(-127.0f) * 1).toF32() == -127.0f);
+    }
+
+    SECTION("fixed point multiply saturates") {
+        REQUIRE((Q8(100.0f) * Q8(2.0f)).raw() == INT16_MAX);
+        REQUIRE((Q8(100.0f) * Q8(-2.0f)).raw() == INT16_MIN);
+        REQUIRE((Q8(-100.0f) * Q8(-100.0f)).raw() == INT16_MAX);
+        REQUIRE((Q16(30000.0f) * Q16(3.0f)).raw() == INT32_MAX);
+        REQUIRE((Q16(-30000.0f) * Q16(3.0f)).raw() == INT32_MIN);
+        REQUIRE((Q8(-128.0f) * Q8(1.0f)).toF32() == -128.0f);
+    }
+
+    SECTION("wide multiply keeps every fractional bit") {
+        const FixedPoint<int16_t, 6> angle(-90.5f);
+        const FixedPoint<int16_t, 10> gain(10.125f);
+        const int32_t product = angle.multiplyWide(gain);
+        REQUIRE(product == (int32_t)(-90.5 * 10.125 * (1 << 16)));
+    }
+
+    SECTION("compare") {
+        REQUIRE(Q8(1.0f) < Q8(1.5f));
+        REQUIRE(Q8(-1.0f) > Q8(-1.5f));
+        REQUIRE(Q8(1.0f) <= Q8(1.0f));
+        REQUIRE(Q8(1.0f) >= Q8(1.0f));
+        REQUIRE(Q8(1.0f) == Q8::fromInt(1));
+        REQUIRE(Q8(1.0f) != Q8(-1.0f));
+    }
+}
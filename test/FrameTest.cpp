@@ -0,0 +1,193 @@
+//
+// Servo Frame Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "servo/Frame.h"
+
+static std::vector<uint8_t> channelBytes(uint16_t duty) {
+    return {0, 0, (uint8_t)(duty & 0xff), (uint8_t)(duty >> 8)};
+}
+
+TEST_CASE("Frame::commit", "[Frame]" ) 
+{
+    Wire = WireMock();
+    Servo::Frame frame;
+
+    SECTION("nothing to send") {
+        REQUIRE(frame.commit() == 0);
+        REQUIRE(Wire.transmissions == 0);
+        REQUIRE(frame.commits() == 0);
+    }
+
+    SECTION("single channel") {
+        frame.set(3, 0x0234);
+        REQUIRE(frame.pending());
+        REQUIRE(frame.commit() == 1);
+        REQUIRE_FALSE(frame.pending());
+        REQUIRE(Wire.writeAddress == PCA9685_ADDRESS);
+        REQUIRE(Wire.transmissions == 1);
+        std::vector<uint8_t> expected = {PCA9685_LED0_ON_L + 3 * 4};
+        std::vector<uint8_t> bytes = channelBytes(0x0234);
+        expected.insert(expected.end(), bytes.begin(), bytes.end());
+        REQUIRE(Wire.writeBuffer == expected);
+    }
+
+    SECTION("every channel fits the Wire buffer in three bursts") {
+        for (uint8_t c = 0; c < PCA9685_CHANNELS; c++) {
+            frame.set(c, 1000 + c);
+        }
+        REQUIRE(frame.commit() == 3);
+        REQUIRE(frame.lastBursts() == 3);
+        REQUIRE(Wire.transmissions == 3);
+        REQUIRE(Wire.writeBuffer.size() == 3 + PCA9685_CHANNELS * PCA9685_CHANNEL_BYTES);
+
+        size_t index = 0;
+        uint8_t channel = 0;
+        while (channel < PCA9685_CHANNELS) {
+            REQUIRE(Wire.writeBuffer[index++] == PCA9685_LED0_ON_L + 4 * channel);
+            const uint8_t count = (PCA9685_CHANNELS - channel < SERVO_BURST_CHANNELS) ? PCA9685_CHANNELS - channel : SERVO_BURST_CHANNELS;
+            REQUIRE(1 + count * PCA9685_CHANNEL_BYTES <= SERVO_WIRE_BUFFER);
+            for (uint8_t c = channel; c < channel + count; c++) {
+                std::vector<uint8_t> bytes(Wire.writeBuffer.begin() + index, Wire.writeBuffer.begin() + index + 4);
+                REQUIRE(bytes == channelBytes(1000 + c));
+                index += 4;
+            }
+            channel += count;
+        }
+    }
+
+    SECTION("gaps split bursts") {
+        frame.set(0, 1);
+        frame.set(1, 2);
+        frame.set(4, 3);
+        frame.set(15, 4);
+        REQUIRE(frame.commit() == 3);
+        REQUIRE(Wire.writeBuffer.size() == 3 + 4 * PCA9685_CHANNEL_BYTES);
+        REQUIRE(Wire.writeBuffer[0] == PCA9685_LED0_ON_L);
+        REQUIRE(Wire.writeBuffer[9] == PCA9685_LED0_ON_L + 4 * 4);
+        REQUIRE(Wire.writeBuffer[14] == PCA9685_LED0_ON_L + 4 * 15);
+    }
+
+    SECTION("last set in a tick wins") {
+        frame.set(2, 100);
+        frame.set(2, 200);
+        REQUIRE(frame.commit() == 1);
+        REQUIRE(frame.duty(2) == 200);
+        REQUIRE(Wire.writeBuffer.size() == 5);
+        REQUIRE(Wire.writeBuffer[3] == 200);
+    }
+
+    SECTION("full off") {
+        frame.set(7, PCA9685_FULL_OFF);
+        frame.commit();
+        REQUIRE(Wire.writeBuffer[4] == 0x10);
+    }
+
+    SECTION("out of range channels are ignored") {
+        frame.set(PCA9685_CHANNELS, 100);
+        REQUIRE_FALSE(frame.pending());
+    }
+
+    SECTION("stats") {
+        frame.set(0, 1);
+        frame.commit();
+        frame.set(1, 1);
+        frame.commit();
+        REQUIRE(frame.commits() == 2);
+        frame.resetStats();
+        REQUIRE(frame.commits() == 0);
+        REQUIRE(frame.maxCommitUs() == 0);
+    }
+}
+
+TEST_CASE("Frame dirty channels", "[Frame]" ) 
+{
+    Wire = WireMock();
+    Servo::Frame frame;
+    for (uint8_t c = 0; c < PCA9685_CHANNELS; c++) {
+        frame.set(c, 1000 + c);
+    }
+    frame.commit();
+    Wire = WireMock();
+
+    SECTION("unchanged duties are not sent") {
+        for (uint8_t c = 0; c < PCA9685_CHANNELS; c++) {
+            frame.set(c, 1000 + c);
+        }
+        REQUIRE_FALSE(frame.pending());
+        REQUIRE(frame.commit() == 0);
+        REQUIRE(Wire.transmissions == 0);
+        REQUIRE(frame.unchanged() == PCA9685_CHANNELS);
+    }
+
+    SECTION("contiguous dirty runs share a burst") {
+        for (uint8_t c = 0; c < PCA9685_CHANNELS; c++) {
+            const bool dirty = (c >= 4 && c <= 6) || (c == 9);
+            frame.set(c, dirty ? 2000 : 1000 + c);
+        }
+        REQUIRE(frame.commit() == 2);
+        REQUIRE(Wire.writeBuffer.size() == 2 + 4 * PCA9685_CHANNEL_BYTES);
+        REQUIRE(Wire.writeBuffer[0] == PCA9685_LED0_ON_L + 4 * 4);
+        REQUIRE(Wire.writeBuffer[13] == PCA9685_LED0_ON_L + 4 * 9);
+    }
+
+    SECTION("changed back within a tick is not sent") {
+        frame.set(3, 1500);
+        frame.set(3, 1003);
+        REQUIRE_FALSE(frame.pending());
+        REQUIRE(frame.commit() == 0);
+        REQUIRE(frame.duty(3) == 1003);
+    }
+
+    SECTION("the committed duty follows each commit") {
+        frame.set(3, 1500);
+        frame.commit();
+        frame.set(3, 1500);
+        REQUIRE_FALSE(frame.pending());
+        frame.set(3, 1003);
+        REQUIRE(frame.pending());
+    }
+
+    SECTION("invalidate sends everything again") {
+        frame.invalidate();
+        frame.set(3, 1003);
+        frame.set(4, 1004);
+        REQUIRE(frame.commit() == 1);
+        REQUIRE(Wire.writeBuffer.size() == 1 + 2 * PCA9685_CHANNEL_BYTES);
+    }
+
+    SECTION("an empty commit clears the last commit telemetry") {
+        REQUIRE(frame.commit() == 0);
+        REQUIRE(frame.lastBursts() == 0);
+        REQUIRE(frame.lastCommitUs() == 0);
+    }
+}
+
+TEST_CASE("Frame::begin", "[Frame]" ) 
+{
+    Wire = WireMock();
+    Servo::Frame frame;
+
+    SECTION("turns on auto-increment") {
+        Wire.readBuffer = {0x01};
+        frame.begin();
+        REQUIRE(Wire.writeBuffer == std::vector<uint8_t>({PCA9685_MODE1, PCA9685_MODE1, 0x01 | PCA9685_MODE1_AI}));
+    }
+
+    SECTION("leaves it alone when already on") {
+        Wire.readBuffer = {PCA9685_MODE1_AI};
+        frame.begin();
+        REQUIRE(Wire.writeBuffer == std::vector<uint8_t>({PCA9685_MODE1}));
+    }
+}
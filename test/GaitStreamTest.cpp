@@ -0,0 +1,118 @@
+//
+// Gait Stream Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "skill/GaitStream.h"
+#include "skill/I2cEeprom.h"
+
+#define GAIT_ADDRESS (0x0104)
+
+// Frame f, joint j has the value f * 10 + j
+static void setupGait(uint8_t frames) {
+    Wire = WireMock();
+    Skill::I2cEeprom::invalidate();
+    Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+    for (uint8_t f = 0; f < frames; f++) {
+        for (uint8_t j = 0; j < WALKING_DOF; j++) {
+            Wire.eeprom[GAIT_ADDRESS + f * WALKING_DOF + j] = f * 10 + j;
+        }
+    }
+}
+
+static void requireFrame(const char* frame, uint8_t index) {
+    REQUIRE(frame != NULL);
+    for (uint8_t j = 0; j < WALKING_DOF; j++) {
+        REQUIRE(frame[j] == index * 10 + j);
+    }
+}
+
+TEST_CASE("GaitStream::begin", "[GaitStream]" ) 
+{
+    setupGait(5);
+    Skill::GaitStream stream;
+    stream.begin(GAIT_ADDRESS, 5);
+
+    SECTION("only loads the first window") {
+        REQUIRE(Wire.bytesRead == GAIT_STREAM_WINDOW_BYTES);
+        REQUIRE(stream.frames() == 5);
+    }
+
+    SECTION("first frame is ready") {
+        const size_t bytesRead = Wire.bytesRead;
+        requireFrame(stream.frame(0), 0);
+        REQUIRE(Wire.bytesRead == bytesRead);
+        REQUIRE(stream.misses() == 0);
+    }
+}
+
+TEST_CASE("GaitStream::prefetch", "[GaitStream]" ) 
+{
+    const uint8_t frames = 7;
+    setupGait(frames);
+    Skill::GaitStream stream;
+    stream.begin(GAIT_ADDRESS, frames);
+
+    SECTION("prefetching keeps every frame ready, including wrap around") {
+        for (uint8_t cycle = 0; cycle < 3; cycle++) {
+            for (uint8_t f = 0; f < frames; f++) {
+                requireFrame(stream.frame(f), f);
+                stream.prefetch();
+            }
+        }
+        REQUIRE(stream.misses() == 0);
+    }
+
+    SECTION("each prefetch reads at most one window") {
+        for (uint8_t f = 0; f < frames; f++) {
+            stream.frame(f);
+            const size_t bytesRead = Wire.bytesRead;
+            stream.prefetch();
+            REQUIRE(Wire.bytesRead - bytesRead <= GAIT_STREAM_WINDOW_BYTES);
+        }
+    }
+
+    SECTION("prefetching twice does not reload") {
+        stream.prefetch();
+        const size_t bytesRead = Wire.bytesRead;
+        stream.prefetch();
+        REQUIRE(Wire.bytesRead == bytesRead);
+    }
+}
+
+TEST_CASE("GaitStream::frame", "[GaitStream]" ) 
+{
+    const uint8_t frames = 6;
+    setupGait(frames);
+    Skill::GaitStream stream;
+    stream.begin(GAIT_ADDRESS, frames);
+
+    SECTION("random access without prefetch still works") {
+        const std::vector<uint8_t> order = {3, 1, 5, 0, 2, 4, 4};
+        for (auto f : order) {
+            requireFrame(stream.frame(f), f);
+        }
+        REQUIRE(stream.misses() > 0);
+    }
+
+    SECTION("out of range") {
+        REQUIRE(stream.frame(frames) == NULL);
+    }
+
+    SECTION("empty gait") {
+        Skill::GaitStream empty;
+        empty.begin(GAIT_ADDRESS, 0);
+        empty.prefetch();
+        REQUIRE(empty.frame(0) == NULL);
+    }
+}
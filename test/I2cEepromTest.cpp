@@ -0,0 +1,102 @@
+//
+// I2C EEPROM Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "skill/I2cEeprom.h"
+
+using I2cEeprom = Skill::I2cEeprom;
+
+static void setupEeprom() {
+    Wire = WireMock();
+    Wire.eeprom = std::vector<int8_t>(I2C_EEPROM_SIZE, 0);
+    for (size_t i = 0; i < Wire.eeprom.size(); i++) {
+        Wire.eeprom[i] = (int8_t)(i * 3 + (i >> 8));
+    }
+    I2cEeprom::invalidate();
+    I2cEeprom::resetStats();
+}
+
+static void requireData(uint16_t address, const char* data, uint16_t len) {
+    for (uint16_t i = 0; i < len; i++) {
+        REQUIRE(data[i] == Wire.eeprom[(address + i) % I2C_EEPROM_SIZE]);
+    }
+}
+
+TEST_CASE("I2cEeprom::read", "[I2cEeprom]" ) 
+{
+    setupEeprom();
+    char data[200];
+
+    SECTION("bursts are as large as the wire buffer allows") {
+        REQUIRE(I2cEeprom::read(0x0105, data, sizeof(data)) == sizeof(data));
+        requireData(0x0105, data, sizeof(data));
+        REQUIRE(Wire.transmissions == 1);
+        REQUIRE(Wire.requests.size() == (sizeof(data) + I2C_EEPROM_BURST - 1) / I2C_EEPROM_BURST);
+        for (auto request : Wire.requests) {
+            REQUIRE(request <= I2C_EEPROM_BURST);
+        }
+        REQUIRE(I2cEeprom::bytesRead() == sizeof(data));
+        REQUIRE(I2cEeprom::requests() == Wire.requests.size());
+    }
+
+    SECTION("reads run across page boundaries") {
+        const uint16_t address = 3 * I2C_EEPROM_PAGE_SIZE - 5;
+        I2cEeprom::read(address, data, 10);
+        requireData(address, data, 10);
+        REQUIRE(Wire.requests.size() == 1);
+    }
+
+    SECTION("sequential reads need no address write") {
+        I2cEeprom::read(0x0200, data, 10);
+        I2cEeprom::read(0x020A, data, 40);
+        requireData(0x020A, data, 40);
+        REQUIRE(Wire.transmissions == 1);
+        REQUIRE(I2cEeprom::addressWrites() == 1);
+    }
+
+    SECTION("non sequential reads set the address") {
+        I2cEeprom::read(0x0200, data, 10);
+        I2cEeprom::read(0x0100, data, 10);
+        requireData(0x0100, data, 10);
+        REQUIRE(Wire.transmissions == 2);
+    }
+
+    SECTION("invalidate forces an address write") {
+        I2cEeprom::read(0x0200, data, 10);
+        I2cEeprom::invalidate();
+        I2cEeprom::read(0x020A, data, 10);
+        requireData(0x020A, data, 10);
+        REQUIRE(Wire.transmissions == 2);
+    }
+
+    SECTION("reads wrap at the end of the device") {
+        const uint16_t address = I2C_EEPROM_SIZE - 20;
+        I2cEeprom::read(address, data, 50);
+        requireData(address, data, 50);
+        for (auto request : Wire.requests) {
+            REQUIRE(request <= I2C_EEPROM_BURST);
+        }
+
+        I2cEeprom::read(30, data, 10);
+        requireData(30, data, 10);
+        REQUIRE(Wire.transmissions == 1);
+    }
+
+    SECTION("unused high address bits are ignored") {
+        I2cEeprom::read(I2C_EEPROM_SIZE + 0x10, data, 10);
+        I2cEeprom::read(0x1A, data, 10);
+        requireData(0x1A, data, 10);
+        REQUIRE(Wire.transmissions == 1);
+    }
+}
@@ -0,0 +1,105 @@
+//
+// IMU FIFO Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+
+#include "state/ImuFifo.h"
+
+using Measurement = Attitude::Measurement;
+
+// Big endian, in the order the MPU6050 writes accel and gyro to its FIFO.
+static void pushSample(std::vector<uint8_t>& bytes, const std::vector<int16_t>& values) {
+    for (int16_t v : values) {
+        bytes.push_back((uint8_t)((uint16_t)v >> 8));
+        bytes.push_back((uint8_t)(v & 0xFF));
+    }
+}
+
+TEST_CASE("ImuFifo::pending", "[ImuFifo]" ) 
+{
+    Attitude::ImuFifo fifo;
+
+    SECTION("whole samples only") {
+        REQUIRE(fifo.pending(0) == 0);
+        REQUIRE(fifo.pending(IMU_FIFO_SAMPLE_BYTES) == 1);
+        REQUIRE(fifo.overflows() == 0);
+    }
+
+    SECTION("at most one batch per read") {
+        REQUIRE(fifo.pending(IMU_FIFO_SAMPLE_BYTES * IMU_FIFO_MAX_BACKLOG) == IMU_FIFO_BATCH);
+        REQUIRE(fifo.overflows() == 0);
+    }
+
+    SECTION("a backlog too old to use is an overflow") {
+        REQUIRE(fifo.pending(IMU_FIFO_SAMPLE_BYTES * (IMU_FIFO_MAX_BACKLOG + 1)) == 0);
+        REQUIRE(fifo.overflows() == 1);
+    }
+
+    SECTION("a partial sample is an overflow") {
+        REQUIRE(fifo.pending(IMU_FIFO_SAMPLE_BYTES + 4) == 0);
+        REQUIRE(fifo.overflows() == 1);
+    }
+}
+
+TEST_CASE("ImuFifo::decode", "[ImuFifo]" ) 
+{
+    Attitude::ImuFifo fifo;
+    std::vector<uint8_t> bytes;
+    Measurement out[IMU_FIFO_BATCH];
+
+    SECTION("accel then gyro, big endian") {
+        pushSample(bytes, {1, -2, 16384, 300, -32768, 32767});
+        fifo.decode(bytes.data(), 1, 100000, out);
+        REQUIRE(out[0].accel.x == 1);
+        REQUIRE(out[0].accel.y == -2);
+        REQUIRE(out[0].accel.z == 16384);
+        REQUIRE(out[0].gyro.x == 300);
+        REQUIRE(out[0].gyro.y == -32768);
+        REQUIRE(out[0].gyro.z == 32767);
+    }
+
+    SECTION("the first batch ends at the time it was read") {
+        pushSample(bytes, {0, 0, 0, 0, 0, 0});
+        pushSample(bytes, {0, 0, 0, 0, 0, 0});
+        fifo.decode(bytes.data(), 2, 100000, out);
+        REQUIRE(fifo.started());
+        REQUIRE(out[0].us == 100000 - IMU_SAMPLE_PERIOD_US);
+        REQUIRE(out[1].us == 100000);
+    }
+
+    SECTION("later samples are one period apart however late they are read") {
+        pushSample(bytes, {0, 0, 0, 0, 0, 0});
+        pushSample(bytes, {0, 0, 0, 0, 0, 0});
+        fifo.decode(bytes.data(), 1, 100000, out);
+        fifo.decode(bytes.data(), 2, 113700, out);
+        REQUIRE(out[0].us == 100000 + IMU_SAMPLE_PERIOD_US);
+        REQUIRE(out[1].us == 100000 + 2 * IMU_SAMPLE_PERIOD_US);
+        fifo.decode(bytes.data(), 1, 114100, out);
+        REQUIRE(out[0].us == 100000 + 3 * IMU_SAMPLE_PERIOD_US);
+    }
+
+    SECTION("restart stamps from the clock again") {
+        pushSample(bytes, {0, 0, 0, 0, 0, 0});
+        fifo.decode(bytes.data(), 1, 100000, out);
+        fifo.restart();
+        REQUIRE_FALSE(fifo.started());
+        fifo.decode(bytes.data(), 1, 500000, out);
+        REQUIRE(out[0].us == 500000);
+    }
+
+    SECTION("stamps wrap with the clock") {
+        pushSample(bytes, {0, 0, 0, 0, 0, 0});
+        fifo.decode(bytes.data(), 1, 0xFFFFFFFF, out);
+        fifo.decode(bytes.data(), 1, 3000, out);
+        REQUIRE(out[0].us == (uint32_t)(0xFFFFFFFF + IMU_SAMPLE_PERIOD_US));
+    }
+}
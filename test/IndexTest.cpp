@@ -0,0 +1,137 @@
+//
+// Skill Index Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <set>
+#include <vector>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+
+#include "skill/Index.h"
+
+#define TABLE_ADDRESS (200)
+
+static void writeTable(const std::vector<char>& table) {
+    EEPROM = EEPROMMock();
+    for (size_t i = 0; i < table.size(); i++) {
+        EEPROM.data[TABLE_ADDRESS + i] = table[i];
+    }
+}
+
+TEST_CASE("Index::build", "[Index]" ) 
+{
+    writeTable({
+        3, 'c', 'a', 't',       'I',    0x34, 0x12, 
+        4, 'l', 'e', 'e', 't',  'I',    0x37, 0x13,
+        4, 's', 't', 'a', 'r',  'I',    0x10, 0x10,
+        2, 'u', 'p',            'I',    0x01, 0x00,
+        4, 'f', 'a', 'i', 'l',  'N',    0x01, 0x00,
+    });
+
+    SECTION("only instincts are indexed") {
+        Skill::Index index;
+        index.build(TABLE_ADDRESS, 5);
+        REQUIRE(index.size() == 4);
+    }
+
+    SECTION("stops at the requested number of skills") {
+        Skill::Index index;
+        index.build(TABLE_ADDRESS, 2);
+        REQUIRE(index.size() == 2);
+        REQUIRE(index.lookup("leet") == 0x1337);
+        REQUIRE(index.lookup("star") == -1);
+    }
+
+    SECTION("rebuild replaces previous entries") {
+        Skill::Index index;
+        index.build(TABLE_ADDRESS, 5);
+        index.build(TABLE_ADDRESS, 1);
+        REQUIRE(index.size() == 1);
+        REQUIRE(index.lookup("cat") == 0x1234);
+        REQUIRE(index.lookup("up") == -1);
+    }
+
+    SECTION("never exceeds capacity") {
+        std::vector<char> table;
+        for (int i = 0; i < SKILL_INDEX_CAPACITY + 5; i++) {
+            table.insert(table.end(), {2, (char)('a' + i / 26), (char)('a' + i % 26), 'I', (char)i, 0});
+        }
+        writeTable(table);
+        Skill::Index index;
+        index.build(TABLE_ADDRESS, SKILL_INDEX_CAPACITY + 5);
+        REQUIRE(index.size() == SKILL_INDEX_CAPACITY);
+    }
+}
+
+TEST_CASE("Index::lookup", "[Index]" ) 
+{
+    std::vector<char> table;
+    const std::vector<std::string> names = {"zero", "wkF", "bk", "balance", "a", "trR", "lifted"};
+    for (size_t i = 0; i < names.size(); i++) {
+        table.push_back(names[i].size());
+        table.insert(table.end(), names[i].begin(), names[i].end());
+        table.insert(table.end(), {'I', (char)(0x10 * i), 0x01});
+    }
+    writeTable(table);
+
+    Skill::Index index;
+    index.build(TABLE_ADDRESS, names.size());
+
+    for (size_t i = 0; i < names.size(); i++) {
+        SECTION(names[i]) {
+            REQUIRE(index.lookup(names[i].c_str()) == (int16_t)(0x100 + 0x10 * i));
+        }
+    }
+
+    SECTION("unknown") {
+        REQUIRE(index.lookup("wkL") == -1);
+        REQUIRE(index.lookup("") == -1);
+    }
+}
+
+TEST_CASE("Index::lookup checks names on a hash match", "[Index]" ) 
+{
+    // "cxex" has the same hash as "cat", and "ewha" the same as "up"
+    REQUIRE(Skill::Index::hash("cxex") == Skill::Index::hash("cat"));
+    REQUIRE(Skill::Index::hash("ewha") == Skill::Index::hash("up"));
+    writeTable({
+        3, 'c', 'a', 't',       'I',    0x34, 0x12, 
+        4, 'l', 'e', 'e', 't',  'I',    0x37, 0x13,
+        4, 'e', 'w', 'h', 'a',  'I',    0x10, 0x10,
+        2, 'u', 'p',            'I',    0x01, 0x00,
+    });
+    Skill::Index index;
+    index.build(TABLE_ADDRESS, 4);
+
+    SECTION("an unknown name with a known hash is not found") {
+        REQUIRE(index.lookup("cxex") == -1);
+        REQUIRE(index.lookup("cat") == 0x1234);
+    }
+
+    SECTION("colliding names in the table both resolve") {
+        REQUIRE(index.lookup("ewha") == 0x1010);
+        REQUIRE(index.lookup("up") == 0x0001);
+    }
+}
+
+TEST_CASE("Index::hash is unique for Bittle skills", "[Index]" ) 
+{
+    const std::vector<std::string> names = {
+        "crF", "wkF", "trF", "bk", "crL", "wkL", "trL", "bkL", "crR", "wkR", "trR", "bkR",
+        "rest", "balance", "vt", "sit", "str", "hi", "pu", "pee", "ck", "pd", "zero",
+        "lifted", "dropped", "rc", "calib", "buttUp", "jy", "stand",
+    };
+    std::set<std::string> unique(names.begin(), names.end());
+    std::set<uint16_t> hashes;
+    for (auto& name : unique) {
+        hashes.insert(Skill::Index::hash(name.c_str()));
+    }
+    REQUIRE(hashes.size() == unique.size());
+}
@@ -0,0 +1,441 @@
+//
+// Skill Cache Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <vector>
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#include "skill/LoaderCached.h"
+#include "skill/GaitStream.h"
+#include "skill/I2cEeprom.h"
+
+using namespace Command;
+using SkillType = Skill::Type;
+
+// Produces skills whose spec bytes are derived from the slot, taking a few steps per load.
+class FakeLoader : public Skill::Loader {
+  public:
+    void load(const Command::Command& command, Skill::Skill& skill) {
+        begin(command, skill);
+        while (!step()) {}
+    }
+
+    void begin(const Command::Command& command, Skill::Skill& skill) {
+        loads++;
+        _skill = &skill;
+        _slot = Skill::slot(command);
+        _steps = stepsPerLoad;
+        skill.clear();
+    }
+
+    bool step() {
+        if (_skill == NULL) {
+            return true;
+        }
+        if (--_steps > 0) {
+            return false;
+        }
+        if (_slot != SKILL_SLOT_NONE) {
+            const bool gait = (lengthOverride == 0) && (_slot < SKILL_MOVE_SLOTS);
+            const uint16_t length = (lengthOverride != 0) ? lengthOverride : gait ? 2 * WALKING_DOF : DOF;
+            _skill->type = gait ? SkillType::Gait : SkillType::Posture;
+            _skill->frames = gait ? 2 : 1;
+            _skill->spec = data;
+            _skill->specLength = length;
+            _skill->progmem = progmem;
+            for (uint16_t i = 0; i < length; i++) {
+                data[i] = _slot + i;
+            }
+            if ((stream != NULL) && (_skill->type == SkillType::Gait)) {
+                stream->begin(streamAddress(_slot), _skill->frames);
+                _skill->stream = stream;
+                _skill->spec = NULL;
+                _skill->specLength = 0;
+            }
+        }
+        _skill = NULL;
+        return true;
+    }
+
+    int loads = 0;
+    int stepsPerLoad = 3;
+    uint16_t lengthOverride = 0;
+    char data[SKILL_CACHE_BYTES + 32];
+    Skill::GaitStream* stream = NULL;
+    bool progmem = false; // Only flagged, the data is still in RAM
+
+    static uint16_t streamAddress(Skill::Slot s) { return 0x100 + (uint16_t)s * 0x40; }
+
+  private:
+    Skill::Skill* _skill = NULL;
+    Skill::Slot _slot = SKILL_SLOT_NONE;
+    int _steps = 0;
+};
+
+static void requireSkillFor(const Command::Command& command, const Skill::Skill& skill) {
+    const Skill::Slot s = Skill::slot(command);
+    REQUIRE(skill.type != SkillType::Invalid);
+    for (uint16_t i = 0; i < skill.specLength; i++) {
+        REQUIRE(skill.spec[i] == (char)(s + i));
+    }
+}
+
+static const Command::Command WALK = Command::Command(Move{Pace::Medium, Direction::Forward});
+static const Command::Command TROT = Command::Command(Move{Pace::Fast, Direction::Forward});
+static const Command::Command CRAWL = Command::Command(Move{Pace::Slow, Direction::Left});
+static const Command::Command BALANCE = Command::Command(Simple::Balance);
+static const Command::Command SIT = Command::Command(Simple::Sit);
+static const Command::Command REST = Command::Command(Simple::Rest);
+static const Command::Command ZERO = Command::Command(Simple::Zero);
+static const Command::Command GREET = Command::Command(Simple::Greet);
+
+TEST_CASE("LoaderCached::load", "[LoaderCached]" ) 
+{
+    FakeLoader fake;
+    Skill::LoaderCached cache(fake);
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("first load misses") {
+        cache.load(WALK, skill);
+        requireSkillFor(WALK, skill);
+        REQUIRE(fake.loads == 1);
+        REQUIRE(cache.misses() == 1);
+        REQUIRE(cache.hits() == 0);
+    }
+
+    SECTION("reload hits without using the wrapped loader") {
+        cache.load(WALK, skill);
+        cache.load(BALANCE, skill);
+        cache.load(WALK, skill);
+        requireSkillFor(WALK, skill);
+        REQUIRE(fake.loads == 2);
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(cache.misses() == 2);
+    }
+
+    SECTION("a hit is the same cached data each time") {
+        cache.load(BALANCE, skill);
+        cache.load(BALANCE, skill);
+        const char* spec = skill.spec;
+        cache.load(BALANCE, skill);
+        REQUIRE(skill.spec == spec);
+    }
+
+    SECTION("cached data survives the wrapped loader reusing its buffer") {
+        cache.load(WALK, skill);
+        cache.load(BALANCE, skill);
+        cache.load(WALK, skill);
+        requireSkillFor(WALK, skill);
+    }
+
+    SECTION("invalid skills are not cached") {
+        cache.load(Command::Command(), skill);
+        cache.load(Command::Command(), skill);
+        REQUIRE(fake.loads == 2);
+        REQUIRE(cache.used() == 0);
+    }
+
+    SECTION("flash skills are not cached") {
+        fake.progmem = true;
+        cache.load(BALANCE, skill);
+        cache.load(BALANCE, skill);
+        REQUIRE(fake.loads == 2);
+        REQUIRE(cache.used() == 0);
+    }
+}
+
+// Streamed gaits read frame f, joint j from the I2C EEPROM as (f + j) offset by the slot.
+static void setupGaitImage() {
+    Wire = WireMock();
+    Skill::I2cEeprom::invalidate();
+    Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+    for (Skill::Slot s = 0; s < SKILL_MOVE_SLOTS; s++) {
+        for (uint16_t i = 0; i < 5 * WALKING_DOF; i++) {
+            Wire.eeprom[FakeLoader::streamAddress(s) + i] = (int8_t)(s * 3 + i);
+        }
+    }
+}
+
+static void requireStreamedGaitFor(const Command::Command& command, const Skill::Skill& skill) {
+    const Skill::Slot s = Skill::slot(command);
+    REQUIRE(skill.type == SkillType::Gait);
+    REQUIRE(skill.spec == NULL);
+    for (uint8_t f = 0; f < skill.frames; f++) {
+        for (uint8_t j = 0; j < WALKING_DOF; j++) {
+            REQUIRE(skill.angle(f, j) == (int8_t)(s * 3 + f * WALKING_DOF + j));
+        }
+    }
+}
+
+TEST_CASE("LoaderCached - streamed gaits", "[LoaderCached]" ) 
+{
+    setupGaitImage();
+    Skill::GaitStream stream;
+    FakeLoader fake;
+    fake.stream = &stream;
+    Skill::LoaderCached cache(fake);
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("only the first window is kept") {
+        cache.load(WALK, skill);
+        REQUIRE(cache.used() == GAIT_STREAM_WINDOW_BYTES);
+        requireStreamedGaitFor(WALK, skill);
+    }
+
+    SECTION("switching back to a recent gait is a hit which reads nothing") {
+        cache.load(WALK, skill);
+        cache.load(TROT, skill);
+        requireStreamedGaitFor(TROT, skill);
+
+        Skill::I2cEeprom::invalidate();
+        const size_t bytesRead = Wire.bytesRead;
+        cache.load(WALK, skill);
+        REQUIRE(fake.loads == 2);
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(Wire.bytesRead == bytesRead);
+        REQUIRE(skill.stream == &stream);
+        REQUIRE(skill.angle(0, 0) == (int8_t)(Skill::slot(WALK) * 3));
+        REQUIRE(Wire.bytesRead == bytesRead);
+
+        requireStreamedGaitFor(WALK, skill);
+        cache.load(TROT, skill);
+        REQUIRE(cache.hits() == 2);
+        requireStreamedGaitFor(TROT, skill);
+    }
+
+    SECTION("gaits and postures share the cache") {
+        for (auto& command : {WALK, SIT, TROT, REST}) {
+            cache.load(command, skill);
+        }
+        for (auto& command : {WALK, SIT, TROT, REST}) {
+            cache.load(command, skill);
+        }
+        REQUIRE(fake.loads == 4);
+        REQUIRE(cache.hits() == 4);
+        requireSkillFor(REST, skill);
+    }
+}
+
+TEST_CASE("LoaderCached - eviction", "[LoaderCached]" ) 
+{
+    FakeLoader fake;
+    Skill::LoaderCached cache(fake);
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("never exceeds the byte budget") {
+        const std::vector<Command::Command> commands = {WALK, TROT, CRAWL, BALANCE, WALK, SIT, TROT, REST, CRAWL};
+        for (auto& command : commands) {
+            cache.load(command, skill);
+            requireSkillFor(command, skill);
+            REQUIRE(cache.used() <= SKILL_CACHE_BYTES);
+        }
+    }
+
+    SECTION("least recently used is evicted first") {
+        // 4 entries of 16 bytes fill the cache
+        cache.load(WALK, skill);
+        cache.load(TROT, skill);
+        cache.load(CRAWL, skill);
+        cache.load(BALANCE, skill);
+        cache.load(WALK, skill); // WALK is now the most recent
+        REQUIRE(fake.loads == 4);
+
+        cache.load(SIT, skill); // Evicts TROT
+        cache.load(WALK, skill);
+        cache.load(CRAWL, skill);
+        cache.load(BALANCE, skill);
+        cache.load(SIT, skill);
+        REQUIRE(fake.loads == 5);
+
+        cache.load(TROT, skill);
+        REQUIRE(fake.loads == 6);
+        requireSkillFor(TROT, skill);
+    }
+
+    SECTION("evicts to make room in the byte budget") {
+        fake.lengthOverride = SKILL_CACHE_BYTES / 2 + 1;
+        cache.load(SIT, skill);
+        cache.load(REST, skill); // Evicts SIT, though there are entries to spare
+        cache.load(REST, skill);
+        REQUIRE(fake.loads == 2);
+        cache.load(SIT, skill);
+        REQUIRE(fake.loads == 3);
+        REQUIRE(cache.used() <= SKILL_CACHE_BYTES);
+    }
+
+    SECTION("remaining entries are intact after compaction") {
+        cache.load(BALANCE, skill);
+        cache.load(WALK, skill);
+        cache.load(SIT, skill);
+        cache.load(TROT, skill);
+        cache.load(WALK, skill);
+        cache.load(SIT, skill);
+        cache.load(TROT, skill);
+        cache.load(CRAWL, skill); // Evicts BALANCE, which is at the start of storage
+        const int loads = fake.loads;
+        for (auto& command : {WALK, SIT, TROT, CRAWL}) {
+            cache.load(command, skill);
+            requireSkillFor(command, skill);
+        }
+        REQUIRE(fake.loads == loads);
+    }
+}
+
+TEST_CASE("LoaderCached::step", "[LoaderCached]" ) 
+{
+    FakeLoader fake;
+    Skill::LoaderCached cache(fake);
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("miss steps the wrapped loader") {
+        cache.begin(ZERO, skill);
+        REQUIRE(cache.step() == false);
+        REQUIRE(cache.step() == false);
+        REQUIRE(cache.step() == true);
+        requireSkillFor(ZERO, skill);
+        REQUIRE(cache.step() == true);
+    }
+
+    SECTION("hit completes immediately") {
+        cache.load(ZERO, skill);
+        skill.clear();
+        cache.begin(ZERO, skill);
+        requireSkillFor(ZERO, skill);
+        REQUIRE(cache.step() == true);
+    }
+}
+
+static void stepUntilIdle(Skill::LoaderCached& cache) {
+    for (int i = 0; (i < 100) && cache.prefetching(); i++) {
+        cache.step();
+    }
+    REQUIRE(cache.prefetching() == false);
+}
+
+TEST_CASE("LoaderCached::prefetch", "[LoaderCached]" ) 
+{
+    FakeLoader fake;
+    Skill::LoaderCached cache(fake);
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("prefetched skill is a hit") {
+        REQUIRE(cache.prefetch(SIT));
+        stepUntilIdle(cache);
+        REQUIRE(cache.prefetches() == 1);
+
+        cache.begin(SIT, skill);
+        REQUIRE(cache.step() == true);
+        requireSkillFor(SIT, skill);
+        REQUIRE(fake.loads == 1);
+        REQUIRE(cache.hits() == 1);
+        REQUIRE(cache.misses() == 0);
+    }
+
+    SECTION("skill in use is not disturbed") {
+        cache.load(BALANCE, skill);
+        REQUIRE(skill.spec != fake.data);
+        REQUIRE(cache.prefetch(SIT));
+        stepUntilIdle(cache);
+        requireSkillFor(BALANCE, skill);
+    }
+
+    SECTION("refused while a load is in progress") {
+        cache.begin(BALANCE, skill);
+        REQUIRE(cache.prefetch(SIT) == false);
+        while (!cache.step()) {}
+        REQUIRE(cache.prefetch(SIT));
+        REQUIRE(cache.prefetch(REST) == false);
+    }
+
+    SECTION("refused for cached or unknown skills") {
+        cache.load(BALANCE, skill);
+        REQUIRE(cache.prefetch(BALANCE) == false);
+        REQUIRE(cache.prefetch(Command::Command()) == false);
+        REQUIRE(fake.loads == 1);
+    }
+
+    SECTION("refused while the skill in use is held by the wrapped loader") {
+        fake.lengthOverride = SKILL_CACHE_BYTES + 1;
+        cache.load(BALANCE, skill);
+        REQUIRE(cache.prefetch(SIT) == false);
+    }
+
+    SECTION("foreground miss cancels the prefetch") {
+        REQUIRE(cache.prefetch(SIT));
+        cache.step();
+        cache.begin(REST, skill);
+        REQUIRE(cache.prefetching() == false);
+        while (!cache.step()) {}
+        requireSkillFor(REST, skill);
+        REQUIRE(cache.prefetches() == 0);
+
+        cache.load(SIT, skill);
+        REQUIRE(cache.misses() == 2);
+    }
+
+    SECTION("foreground hit lets the prefetch continue") {
+        cache.load(BALANCE, skill);
+        REQUIRE(cache.prefetch(SIT));
+        cache.step();
+        cache.begin(BALANCE, skill);
+        REQUIRE(cache.prefetching());
+        stepUntilIdle(cache);
+        REQUIRE(cache.prefetches() == 1);
+        requireSkillFor(BALANCE, skill);
+    }
+
+    SECTION("skill in use is never evicted") {
+        for (auto& command : {WALK, TROT, CRAWL, BALANCE}) {
+            cache.load(command, skill);
+        }
+        for (auto& command : {SIT, REST, ZERO, GREET}) {
+            REQUIRE(cache.prefetch(command));
+            stepUntilIdle(cache);
+            requireSkillFor(BALANCE, skill);
+        }
+        const int loads = fake.loads;
+        cache.load(BALANCE, skill);
+        REQUIRE(fake.loads == loads);
+        cache.load(GREET, skill);
+        REQUIRE(fake.loads == loads);
+    }
+
+    SECTION("skill in use follows its data when storage is compacted") {
+        for (auto& command : {WALK, TROT, CRAWL, BALANCE}) {
+            cache.load(command, skill);
+        }
+        for (auto& command : {SIT, REST}) {
+            REQUIRE(cache.prefetch(command));
+            stepUntilIdle(cache);
+        }
+        Skill::Skill cached = Skill::Skill::Empty();
+        cache.load(BALANCE, cached);
+        REQUIRE(skill.spec == cached.spec);
+        requireSkillFor(BALANCE, skill);
+    }
+
+    SECTION("skill in use pointed away from the cache is left alone") {
+        // Members are laid out in order, so the pose sits after the cache storage where compaction would move it
+        struct CacheThenPose {
+            Skill::LoaderCached cache;
+            char pose[DOF];
+        } held{Skill::LoaderCached(fake), {}};
+        for (auto& command : {WALK, TROT, CRAWL, BALANCE}) {
+            held.cache.load(command, skill);
+        }
+        skill.spec = held.pose;
+        for (auto& command : {SIT, REST}) {
+            REQUIRE(held.cache.prefetch(command));
+            stepUntilIdle(held.cache);
+        }
+        REQUIRE(skill.spec == held.pose);
+    }
+}
@@ -10,12 +10,14 @@
 #include "Helpers.h"
 
 #include <vector>
+#include <algorithm>
 
 #include "Arduino.h"
 #include "Wire.h"
 #include "EEPROM.h"
 
 #include "skill/LoaderEeprom.h"
+#include "skill/I2cEeprom.h"
 
 #include "math/Trig.h"
 
@@ -36,16 +38,22 @@ class LoaderWhitebox : public LoaderEeprom {
         int16_t lookupAddressByName(const char* name) {
             return _lookupAddressByName(name);
         }
+        void beginFromAddress(uint16_t address, Skill::Skill& skill) {
+            _begin(address, skill);
+        }
+        uint16_t arenaUsed() const {
+            return _arena.used();
+        }
 };
 
 TEST_CASE("LoaderEeprom::_lookupAddressByName", "[LoaderEeprom]" ) 
 {
     const std::vector<char> nameData = {
-        3, 'c', 'a', 't',       'I',    0x34, 0x12, 
-        4, 'l', 'e', 'e', 't',  'I',    0x37, 0x13,
-        4, 's', 't', 'a', 'r',  'I',    0x10, 0x10,
-        2, 'u', 'p',            'I',    0x01, 0x00,
-        4, 'f', 'a', 'i', 'l',  'N',    0x01, 0x00,
+        3, 's', 'i', 't',       'I',    0x34, 0x12, 
+        4, 'r', 'e', 's', 't',  'I',    0x37, 0x13,
+        4, 'l', 'e', 'e', 't',  'I',    0x10, 0x10,
+        2, 'h', 'i',            'I',    0x01, 0x00,
+        3, 'p', 'e', 'e',       'N',    0x01, 0x00,
     };
     for (size_t i = 0; i<nameData.size(); i++) {
         EEPROM.data[200 + i] = nameData[i];
@@ -59,23 +67,28 @@ TEST_CASE("LoaderEeprom::_lookupAddressByName", "[LoaderEeprom]" )
 
     const std::vector<TestCase> testCases = {
         TestCase{ 
-            .name = "valid - cat",
-            .skillName = "cat",
+            .name = "valid - sit",
+            .skillName = "sit",
             .expected = 0x1234,    
         },
         TestCase{ 
-            .name = "valid - leet",
-            .skillName = "leet",
+            .name = "valid - rest",
+            .skillName = "rest",
             .expected = 0x1337,    
         },
         TestCase{ 
-            .name = "valid - up",
-            .skillName = "up",
+            .name = "valid - hi",
+            .skillName = "hi",
             .expected = 0x0001,    
         },
         TestCase{ 
-            .name = "invalid - fail",
-            .skillName = "fail",
+            .name = "invalid - not an instinct",
+            .skillName = "pee",
+            .expected = -1,    
+        },
+        TestCase{ 
+            .name = "invalid - not in a slot",
+            .skillName = "leet",
             .expected = -1,    
         },
         TestCase{ 
@@ -93,6 +106,26 @@ TEST_CASE("LoaderEeprom::_lookupAddressByName", "[LoaderEeprom]" )
     }
 }
 
+TEST_CASE("LoaderEeprom slots are resolved by name", "[LoaderEeprom]" ) 
+{
+    // "bmgz" has the same djb2-16 hash as "sit"
+    const std::vector<char> nameData = {
+        4, 'b', 'm', 'g', 'z',  'I',    0x22, 0x22,
+        4, 'r', 'e', 's', 't',  'I',    0x37, 0x13,
+    };
+    REQUIRE(Skill::Index::hash("bmgz") == Skill::Index::hash("sit"));
+    for (size_t i = 0; i < 200; i++) {
+        EEPROM.data[200 + i] = 0;
+    }
+    for (size_t i = 0; i<nameData.size(); i++) {
+        EEPROM.data[200 + i] = nameData[i];
+    }
+
+    LoaderWhitebox loader = LoaderWhitebox();
+    REQUIRE(loader.lookupAddressByName("sit") == -1);
+    REQUIRE(loader.lookupAddressByName("rest") == 0x1337);
+}
+
 TEST_CASE("LoaderEeprom::_loadFromAddress", "[LoaderEeprom]" ) 
 { 
     struct TestCase {
@@ -192,6 +225,7 @@ TEST_CASE("LoaderEeprom::_loadFromAddress", "[LoaderEeprom]" )
     for (auto& tc : testCases) {
         SECTION(tc.name) {            
             Wire = WireMock();
+            Skill::I2cEeprom::invalidate();
             Wire.readBuffer = tc.readBuffer;
 
             LoaderWhitebox loader = LoaderWhitebox();
@@ -211,6 +245,10 @@ TEST_CASE("LoaderEeprom::_loadFromAddress", "[LoaderEeprom]" )
             for (size_t i = 0; i< tc.expectedSpec.size(); i++) {
                 REQUIRE(tc.expectedSpec[i] == skill.spec[i]);
             }
+            for (uint8_t f = 0; f < skill.frames; f++) {
+                REQUIRE(skill.frame(f) == skill.spec + f * skill.frameSize());
+            }
+            REQUIRE(skill.frame(skill.frames) == NULL);
             if (tc.expected.type == Type::Behaviour) {
                 REQUIRE(tc.expected.loopSpec.firstRow == skill.loopSpec.firstRow);
                 REQUIRE(tc.expected.loopSpec.finalRow == skill.loopSpec.finalRow);
@@ -220,3 +258,408 @@ TEST_CASE("LoaderEeprom::_loadFromAddress", "[LoaderEeprom]" )
     }
 }
 
+
+TEST_CASE("LoaderEeprom::_loadFromAddress - arena", "[LoaderEeprom]" ) 
+{
+    LoaderWhitebox loader = LoaderWhitebox();
+
+    SECTION("largest gait fits") {
+        Wire = WireMock();
+        Skill::I2cEeprom::invalidate();
+        Wire.readBuffer = std::vector<int8_t>(4 + MAX_GAIT_FRAMES * WALKING_DOF, 0);
+        Wire.readBuffer[0] = MAX_GAIT_FRAMES;
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.loadFromAddress(0, skill);
+        REQUIRE(skill.type == Type::Gait);
+        REQUIRE(skill.specLength == MAX_GAIT_FRAMES * WALKING_DOF);
+        REQUIRE(loader.arenaHighWatermark() == MAX_GAIT_FRAMES * WALKING_DOF);
+    }
+
+    SECTION("largest behaviour fits") {
+        Wire = WireMock();
+        Skill::I2cEeprom::invalidate();
+        Wire.readBuffer = std::vector<int8_t>(7 + MAX_BEHAVIOUR_FRAMES * (DOF + 4), 0);
+        Wire.readBuffer[0] = -MAX_BEHAVIOUR_FRAMES;
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.loadFromAddress(0, skill);
+        REQUIRE(skill.type == Type::Behaviour);
+        REQUIRE(skill.specLength == MAX_BEHAVIOUR_FRAMES * (DOF + 4));
+    }
+
+    SECTION("too large is rejected") {
+        Wire = WireMock();
+        Skill::I2cEeprom::invalidate();
+        Wire.readBuffer = std::vector<int8_t>(4, 0);
+        Wire.readBuffer[0] = MAX_GAIT_FRAMES + 1;
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.loadFromAddress(0, skill);
+        REQUIRE(skill.type == Type::Invalid);
+        REQUIRE(skill.spec == NULL);
+        REQUIRE(skill.specLength == 0);
+    }
+
+    SECTION("reloading reuses the arena") {
+        for (int i = 0; i < 3; i++) {
+            Wire = WireMock();
+            Skill::I2cEeprom::invalidate();
+            Wire.readBuffer = std::vector<int8_t>(4 + 3 * WALKING_DOF, 0);
+            Wire.readBuffer[0] = 3;
+            Skill::Skill skill = Skill::Skill::Empty();
+            loader.loadFromAddress(0, skill);
+            REQUIRE(loader.arenaUsed() == 3 * WALKING_DOF);
+        }
+    }
+}
+
+TEST_CASE("LoaderEeprom::_loadFromAddress - streamed gaits", "[LoaderEeprom]" ) 
+{
+    Wire = WireMock();
+    Skill::I2cEeprom::invalidate();
+    Wire.eeprom = std::vector<int8_t>(0x200, 0);
+    const std::vector<int8_t> gait = {
+        3, 5, -5, 1,
+        20,  21,  22,  23,  24,  25,  26,  27,
+        30,  31,  32,  33,  34,  35,  36,  37,
+        40,  41,  42,  43,  44,  45,  46,  47,
+    };
+    std::copy(gait.begin(), gait.end(), Wire.eeprom.begin() + 0x100);
+
+    Skill::GaitStream stream;
+    LoaderWhitebox loader = LoaderWhitebox();
+    loader.streamGaits(&stream);
+    Skill::Skill skill = Skill::Skill::Empty();
+    loader.loadFromAddress(0x100, skill);
+
+    REQUIRE(skill.type == Type::Gait);
+    REQUIRE(skill.frames == 3);
+    REQUIRE(skill.nominalRoll == 5);
+    REQUIRE(skill.nominalPitch == -5);
+    REQUIRE(skill.spec == NULL);
+    REQUIRE(skill.stream == &stream);
+    REQUIRE(Wire.bytesRead == 4 + GAIT_STREAM_WINDOW_BYTES);
+
+    for (uint8_t f = 0; f < 3; f++) {
+        const char* frame = skill.frame(f);
+        for (uint8_t j = 0; j < WALKING_DOF; j++) {
+            REQUIRE(frame[j] == gait[4 + f * WALKING_DOF + j]);
+        }
+    }
+}
+
+TEST_CASE("LoaderEeprom::step", "[LoaderEeprom]" ) 
+{
+    struct TestCase {
+        std::string name;
+        std::vector<int8_t> header;
+        uint16_t specLength;
+        bool streamed;
+        Type expectedType;
+    };
+
+    const std::vector<TestCase> testCases = {
+        {"posture", {1, 0, 0, 1}, DOF, false, Type::Posture},
+        {"gait", {MAX_GAIT_FRAMES, 0, 0, 1}, MAX_GAIT_FRAMES * WALKING_DOF, false, Type::Gait},
+        {"streamed gait", {MAX_GAIT_FRAMES, 0, 0, 1}, MAX_GAIT_FRAMES * WALKING_DOF, true, Type::Gait},
+        {"behaviour", {-MAX_BEHAVIOUR_FRAMES, 0, 0, 1, 1, 2, 3}, MAX_BEHAVIOUR_FRAMES * (DOF + 4), false, Type::Behaviour},
+    };
+
+    for (auto& tc : testCases) {
+        SECTION(tc.name) {
+            const uint16_t address = 0x0123;
+            Wire = WireMock();
+            Skill::I2cEeprom::invalidate();
+            Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+            std::copy(tc.header.begin(), tc.header.end(), Wire.eeprom.begin() + address);
+            for (uint16_t i = 0; i < tc.specLength; i++) {
+                Wire.eeprom[address + tc.header.size() + i] = (int8_t)(i * 7);
+            }
+
+            Skill::GaitStream stream;
+            LoaderWhitebox loader = LoaderWhitebox();
+            if (tc.streamed) {
+                loader.streamGaits(&stream);
+            }
+            Skill::Skill skill = Skill::Skill::Empty();
+            loader.beginFromAddress(address, skill);
+            REQUIRE(Wire.bytesRead == 0);
+
+            size_t steps = 0;
+            size_t worstStepBytes = 0;
+            bool done = false;
+            while (!done) {
+                const size_t bytesRead = Wire.bytesRead;
+                done = loader.step();
+                worstStepBytes = std::max(worstStepBytes, Wire.bytesRead - bytesRead);
+                if (!done) {
+                    REQUIRE(skill.type == Type::Invalid);
+                }
+                REQUIRE(++steps < 100);
+            }
+
+            REQUIRE(worstStepBytes <= LOADER_STEP_BYTES);
+            REQUIRE(skill.type == tc.expectedType);
+            if (!tc.streamed) {
+                REQUIRE(steps >= (tc.specLength + LOADER_STEP_BYTES - 1) / LOADER_STEP_BYTES);
+                REQUIRE(skill.specLength == tc.specLength);
+            }
+            for (uint8_t f = 0; f < skill.frames; f++) {
+                const char* frame = skill.frame(f);
+                for (uint8_t j = 0; j < skill.frameSize(); j++) {
+                    REQUIRE(frame[j] == (int8_t)((f * skill.frameSize() + j) * 7));
+                }
+            }
+            if (tc.expectedType == Type::Behaviour) {
+                REQUIRE(skill.loopSpec.firstRow == 1);
+                REQUIRE(skill.loopSpec.finalRow == 2);
+                REQUIRE(skill.loopSpec.count == 3);
+            }
+            REQUIRE(loader.step() == true);
+        }
+    }
+
+    SECTION("begin restarts a load in progress") {
+        Wire = WireMock();
+        Skill::I2cEeprom::invalidate();
+        Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+        Wire.eeprom[0x100] = MAX_GAIT_FRAMES;
+        Wire.eeprom[0x300] = 1;
+        Wire.eeprom[0x304] = 42;
+
+        LoaderWhitebox loader = LoaderWhitebox();
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.beginFromAddress(0x100, skill);
+        REQUIRE(loader.step() == false);
+        loader.beginFromAddress(0x300, skill);
+        REQUIRE(skill.type == Type::Invalid);
+        while (!loader.step()) {}
+        REQUIRE(skill.type == Type::Posture);
+        REQUIRE(skill.spec[0] == 42);
+    }
+
+    SECTION("idle") {
+        LoaderWhitebox loader = LoaderWhitebox();
+        REQUIRE(loader.step() == true);
+    }
+}
+
+TEST_CASE("LoaderEeprom - delta coded skills", "[LoaderEeprom]" ) 
+{
+    struct TestCase {
+        std::string name;
+        std::vector<int8_t> header;
+        uint8_t frames;
+        uint8_t frameSize;
+        Type expectedType;
+    };
+
+    const std::vector<TestCase> testCases = {
+        {"posture", {1, 2, -3, (int8_t)(1 | SKILL_DELTA_FLAG)}, 1, DOF, Type::Posture},
+        {"gait", {MAX_GAIT_FRAMES, 0, 0, (int8_t)(1 | SKILL_DELTA_FLAG)}, MAX_GAIT_FRAMES, WALKING_DOF, Type::Gait},
+        {"double angle gait", {20, 0, 0, (int8_t)(2 | SKILL_DELTA_FLAG)}, 20, WALKING_DOF, Type::Gait},
+        {"behaviour", {-MAX_BEHAVIOUR_FRAMES, 0, 0, (int8_t)(1 | SKILL_DELTA_FLAG), 1, 2, 3}, MAX_BEHAVIOUR_FRAMES, DOF + 4, Type::Behaviour},
+    };
+
+    for (auto& tc : testCases) {
+        SECTION(tc.name) {
+            // Smooth joint motion with the occasional large jump
+            std::vector<char> spec;
+            for (uint8_t f = 0; f < tc.frames; f++) {
+                for (uint8_t j = 0; j < tc.frameSize; j++) {
+                    spec.push_back((char)(int8_t)(45.0 * sin(2.0 * M_PI * f / tc.frames + j) + ((f % 7 == 0) ? 30 : 0)));
+                }
+            }
+            std::vector<char> packed(spec.size() * 2);
+            const uint16_t packedLength = Skill::deltaEncode(spec.data(), spec.size(), tc.frameSize, packed.data(), packed.size());
+            REQUIRE(packedLength > 0);
+
+            const uint16_t address = 0x0240;
+            Wire = WireMock();
+            Skill::I2cEeprom::invalidate();
+            Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+            std::vector<int8_t> image = tc.header;
+            image.push_back(packedLength & 0xFF);
+            image.push_back(packedLength >> 8);
+            image.insert(image.end(), packed.begin(), packed.begin() + packedLength);
+            std::copy(image.begin(), image.end(), Wire.eeprom.begin() + address);
+
+            Skill::GaitStream stream;
+            LoaderWhitebox loader = LoaderWhitebox();
+            loader.streamGaits(&stream); // Delta coded gaits cannot be streamed
+            Skill::Skill skill = Skill::Skill::Empty();
+            loader.beginFromAddress(address, skill);
+
+            size_t worstStepBytes = 0;
+            bool done = false;
+            for (int steps = 0; !done; steps++) {
+                const size_t bytesRead = Wire.bytesRead;
+                done = loader.step();
+                worstStepBytes = std::max(worstStepBytes, Wire.bytesRead - bytesRead);
+                REQUIRE(steps < 100);
+            }
+
+            REQUIRE(worstStepBytes <= LOADER_STEP_BYTES);
+            REQUIRE(Wire.bytesRead == image.size());
+            REQUIRE(skill.type == tc.expectedType);
+            REQUIRE(skill.stream == NULL);
+            REQUIRE(skill.frames == tc.frames);
+            REQUIRE(skill.nominalRoll == tc.header[1]);
+            REQUIRE(skill.nominalPitch == tc.header[2]);
+            REQUIRE(skill.doubleAngles == (((uint8_t)tc.header[3] & ~SKILL_DELTA_FLAG) == 2));
+            REQUIRE(skill.specLength == spec.size());
+            for (uint16_t i = 0; i < spec.size(); i++) {
+                REQUIRE(skill.spec[i] == spec[i]);
+            }
+            if (tc.expectedType == Type::Behaviour) {
+                REQUIRE(skill.loopSpec.firstRow == 1);
+                REQUIRE(skill.loopSpec.finalRow == 2);
+                REQUIRE(skill.loopSpec.count == 3);
+            }
+        }
+    }
+
+    SECTION("truncated data fails") {
+        Wire = WireMock();
+        Skill::I2cEeprom::invalidate();
+        Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+        const std::vector<int8_t> image = {1, 0, 0, (int8_t)(1 | SKILL_DELTA_FLAG), 2, 0, 0x11, 0x22};
+        std::copy(image.begin(), image.end(), Wire.eeprom.begin() + 0x100);
+
+        LoaderWhitebox loader = LoaderWhitebox();
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.loadFromAddress(0x100, skill);
+        REQUIRE(skill.type == Type::Invalid);
+    }
+
+    SECTION("zero packed length fails instead of stalling") {
+        Wire = WireMock();
+        Skill::I2cEeprom::invalidate();
+        Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+        const std::vector<int8_t> image = {1, 0, 0, (int8_t)(1 | SKILL_DELTA_FLAG), 0, 0, 0x11, 0x22};
+        std::copy(image.begin(), image.end(), Wire.eeprom.begin() + 0x100);
+
+        LoaderWhitebox loader = LoaderWhitebox();
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.beginFromAddress(0x100, skill);
+        bool done = false;
+        for (int steps = 0; !done; steps++) {
+            done = loader.step();
+            REQUIRE(steps < 10);
+        }
+        REQUIRE(skill.type == Type::Invalid);
+
+        loader.loadFromAddress(0x100, skill);
+        REQUIRE(skill.type == Type::Invalid);
+    }
+}
+
+TEST_CASE("LoaderEeprom::load", "[LoaderEeprom]" ) 
+{
+    const std::vector<std::string> names = {
+        "crF", "wkF", "trF", "bk", "crL", "wkL", "trL", "bkL", "crR", "wkR", "trR", "bkR",
+        "rest", "balance", "vt", "sit", "str", "hi", "pu", "pee", "ck", "pd", "zero",
+        "lifted", "dropped", "rc", "calib",
+    };
+    EEPROM = EEPROMMock();
+    size_t offset = 200;
+    for (size_t i = 0; i < names.size(); i++) {
+        EEPROM.data[offset++] = names[i].size();
+        for (char c : names[i]) {
+            EEPROM.data[offset++] = c;
+        }
+        EEPROM.data[offset++] = 'I';
+        EEPROM.data[offset++] = (int8_t)(i * 0x20);
+        EEPROM.data[offset++] = 0x02;
+    }
+
+    struct TestCase {
+        std::string name;
+        Command::Command command;
+        int32_t expectedAddress;
+    };
+
+    auto address = [&](const std::string& name) {
+        const size_t i = std::find(names.begin(), names.end(), name) - names.begin();
+        return (int32_t)(0x200 | (uint8_t)(i * 0x20));
+    };
+
+    const std::vector<TestCase> testCases = {
+        {"walk forward", Command::Command(Command::Move{Command::Pace::Medium, Command::Direction::Forward}), address("wkF")},
+        {"crawl left", Command::Command(Command::Move{Command::Pace::Slow, Command::Direction::Left}), address("crL")},
+        {"trot right", Command::Command(Command::Move{Command::Pace::Fast, Command::Direction::Right}), address("trR")},
+        {"back", Command::Command(Command::Move{Command::Pace::Reverse, Command::Direction::Forward}), address("bk")},
+        {"balance", Command::Command(Command::Simple::Balance), address("balance")},
+        {"recover", Command::Command(Command::Simple::Recover), address("rc")},
+        {"calibrate", Command::Command(Command::WithArgs{Command::ArgType::Calibrate, 0, {}}), address("calib")},
+        {"pause", Command::Command(Command::Simple::Pause), -1},
+        {"beep", Command::Command(Command::WithArgs{Command::ArgType::Beep, 0, {}}), -1},
+        {"none", Command::Command(), -1},
+    };
+
+    LoaderEeprom loader = LoaderEeprom();
+    for (auto& tc : testCases) {
+        SECTION(tc.name) {
+            Wire = WireMock();
+            Skill::I2cEeprom::invalidate();
+            Wire.readBuffer = std::vector<int8_t>(4 + DOF, 0);
+            Wire.readBuffer[0] = 1;
+
+            Skill::Skill skill = Skill::Skill::Empty();
+            loader.load(tc.command, skill);
+
+            if (tc.expectedAddress == -1) {
+                REQUIRE(Wire.writeBuffer.size() == 0);
+                REQUIRE(skill.type == Type::Invalid);
+            } else {
+                REQUIRE(Wire.writeBuffer.size() == 2);
+                REQUIRE(Wire.writeBuffer[0] == ((tc.expectedAddress >> 8) & 0xFF));
+                REQUIRE(Wire.writeBuffer[1] == (tc.expectedAddress & 0xFF));
+                REQUIRE(skill.type == Type::Posture);
+            }
+            skill.clear();
+        }
+    }
+}
+
+TEST_CASE("LoaderEeprom::checkImage", "[LoaderEeprom]" ) 
+{
+    const std::vector<std::string> names = {"wkF", "balance", "sit"};
+    EEPROM = EEPROMMock();
+    size_t offset = 200;
+    for (size_t i = 0; i < names.size(); i++) {
+        EEPROM.data[offset++] = names[i].size();
+        for (char c : names[i]) {
+            EEPROM.data[offset++] = c;
+        }
+        EEPROM.data[offset++] = 'I';
+        EEPROM.data[offset++] = 0x00;
+        EEPROM.data[offset++] = (int8_t)(i + 1);
+    }
+
+    Wire = WireMock();
+    Skill::I2cEeprom::invalidate();
+    Wire.eeprom = std::vector<int8_t>(0x1000, 0);
+    Wire.eeprom[0x100] = MAX_GAIT_FRAMES + 1;
+    Wire.eeprom[0x200] = -MAX_BEHAVIOUR_FRAMES;
+    Wire.eeprom[0x300] = 1;
+
+    LoaderEeprom loader = LoaderEeprom();
+    REQUIRE(loader.checkImage() == 1);
+
+    SECTION("a skill too large for the arena is never loaded") {
+        Skill::I2cEeprom::invalidate();
+        const size_t bytesRead = Wire.bytesRead;
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.load(Command::Command(Command::Move{Command::Pace::Medium, Command::Direction::Forward}), skill);
+        REQUIRE(skill.type == Type::Invalid);
+        REQUIRE(Wire.bytesRead == bytesRead);
+    }
+
+    SECTION("skills which fit still load") {
+        Skill::Skill skill = Skill::Skill::Empty();
+        loader.load(Command::Command(Command::Simple::Balance), skill);
+        REQUIRE(skill.type == Type::Behaviour);
+        REQUIRE(skill.frames == MAX_BEHAVIOUR_FRAMES);
+        loader.load(Command::Command(Command::Simple::Sit), skill);
+        REQUIRE(skill.type == Type::Posture);
+    }
+}
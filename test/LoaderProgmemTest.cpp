@@ -0,0 +1,203 @@
+//
+// Progmem Skill Loader Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include "Arduino.h"
+
+#include "skill/LoaderProgmem.h"
+#include "skill/LoaderComposite.h"
+#include "skill/LoaderCached.h"
+#include "skill/Delta.h"
+
+using namespace Command;
+using SkillType = Skill::Type;
+
+static const char sit[] PROGMEM = {
+    1, 0, -30, 1,
+    0, 0, -45, 0, -5, -5, 20, 20, 45, 45, 105, 105, 45, 45, -45, -45,
+};
+
+static const char walk[] PROGMEM = {
+    3, 0, 0, 2,
+    10, 11, 12, 13, 14, 15, 16, 17,
+    20, 21, 22, 23, 24, 25, 26, 27,
+    30, 31, 32, 33, 34, 35, 36, 37,
+};
+
+static const char greet[] PROGMEM = {
+    -2, 0, 0, 1, 0, 1, 3,
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 8, 0, 0, 0,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 8, 1, 0, 0,
+};
+
+static const char packed[] PROGMEM = {
+    1, 0, 0, (char)(1 | SKILL_DELTA_FLAG), 8, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+static const Skill::ProgmemSkill TABLE[] PROGMEM = {
+    {Skill::slot(Simple::Sit), sit},
+    {Skill::slot(Move{Pace::Medium, Direction::Forward}), walk},
+    {Skill::slot(Simple::Greet), greet},
+    {Skill::slot(Simple::Zero), packed},
+};
+
+TEST_CASE("LoaderProgmem::load", "[LoaderProgmem]" ) 
+{
+    Skill::LoaderProgmem loader(TABLE, sizeof(TABLE) / sizeof(TABLE[0]));
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("posture") {
+        loader.load(Command::Command(Simple::Sit), skill);
+        REQUIRE(skill.type == SkillType::Posture);
+        REQUIRE(skill.frames == 1);
+        REQUIRE(skill.nominalPitch == -30);
+        REQUIRE(skill.doubleAngles == false);
+        REQUIRE(skill.progmem);
+        REQUIRE(skill.spec == sit + 4);
+        REQUIRE(skill.specLength == DOF);
+        for (uint8_t j = 0; j < DOF; j++) {
+            REQUIRE(skill.angle(0, j) == sit[4 + j]);
+        }
+    }
+
+    SECTION("gait") {
+        loader.load(Command::Command(Move{Pace::Medium, Direction::Forward}), skill);
+        REQUIRE(skill.type == SkillType::Gait);
+        REQUIRE(skill.frames == 3);
+        REQUIRE(skill.doubleAngles == true);
+        REQUIRE(skill.specLength == 3 * WALKING_DOF);
+        for (uint8_t f = 0; f < 3; f++) {
+            char frame[WALKING_DOF];
+            skill.copyFrame(f, frame);
+            for (uint8_t j = 0; j < WALKING_DOF; j++) {
+                REQUIRE(frame[j] == (f + 1) * 10 + j);
+            }
+        }
+    }
+
+    SECTION("behaviour") {
+        loader.load(Command::Command(Simple::Greet), skill);
+        REQUIRE(skill.type == SkillType::Behaviour);
+        REQUIRE(skill.frames == 2);
+        REQUIRE(skill.loopSpec.firstRow == 0);
+        REQUIRE(skill.loopSpec.finalRow == 1);
+        REQUIRE(skill.loopSpec.count == 3);
+        REQUIRE(skill.angle(1, 0) == 21);
+        REQUIRE(skill.angle(1, DOF + 1) == 1);
+    }
+
+    SECTION("reads outside the skill are zero") {
+        loader.load(Command::Command(Move{Pace::Medium, Direction::Forward}), skill);
+        REQUIRE(skill.angle(3, 0) == 0);
+        REQUIRE(skill.angle(0, WALKING_DOF) == 0);
+        skill.spec = NULL;
+        REQUIRE(skill.angle(0, 0) == 0);
+        REQUIRE(Skill::Skill::Empty().angle(0, 0) == 0);
+    }
+
+    SECTION("flash frames are not handed out as RAM pointers") {
+        loader.load(Command::Command(Simple::Sit), skill);
+        REQUIRE(skill.frame(0) == NULL);
+    }
+
+    SECTION("missing skills are invalid") {
+        loader.load(Command::Command(Simple::Rest), skill);
+        REQUIRE(skill.type == SkillType::Invalid);
+        loader.load(Command::Command(), skill);
+        REQUIRE(skill.type == SkillType::Invalid);
+    }
+
+    SECTION("delta coded skills are not supported") {
+        loader.load(Command::Command(Simple::Zero), skill);
+        REQUIRE(skill.type == SkillType::Invalid);
+    }
+}
+
+// Completes loads of any known slot over a few steps, with the data held in RAM.
+class SteppedLoader : public Skill::Loader {
+  public:
+    void load(const Command::Command& command, Skill::Skill& skill) {
+        begin(command, skill);
+        while (!step()) {}
+    }
+
+    void begin(const Command::Command& command, Skill::Skill& skill) {
+        loads++;
+        skill.clear();
+        _skill = &skill;
+        _steps = 3;
+    }
+
+    bool step() {
+        if (_skill == NULL) {
+            return true;
+        }
+        if (--_steps > 0) {
+            return false;
+        }
+        _skill->type = SkillType::Posture;
+        _skill->frames = 1;
+        _skill->spec = data;
+        _skill->specLength = DOF;
+        _skill = NULL;
+        return true;
+    }
+
+    int loads = 0;
+    char data[DOF] = {7};
+
+  private:
+    Skill::Skill* _skill = NULL;
+    int _steps = 0;
+};
+
+TEST_CASE("LoaderComposite", "[LoaderProgmem]" ) 
+{
+    Skill::LoaderProgmem flash(TABLE, sizeof(TABLE) / sizeof(TABLE[0]));
+    SteppedLoader eeprom;
+    Skill::LoaderComposite loader(flash, eeprom);
+    Skill::Skill skill = Skill::Skill::Empty();
+
+    SECTION("flash skills complete immediately") {
+        loader.begin(Command::Command(Simple::Sit), skill);
+        REQUIRE(loader.step() == true);
+        REQUIRE(skill.type == SkillType::Posture);
+        REQUIRE(skill.progmem);
+        REQUIRE(eeprom.loads == 0);
+        REQUIRE(loader.primaryLoads() == 1);
+    }
+
+    SECTION("other skills fall back") {
+        loader.begin(Command::Command(Simple::Rest), skill);
+        REQUIRE(loader.step() == false);
+        REQUIRE(loader.step() == false);
+        REQUIRE(loader.step() == true);
+        REQUIRE(skill.type == SkillType::Posture);
+        REQUIRE(skill.progmem == false);
+        REQUIRE(skill.angle(0, 0) == 7);
+        REQUIRE(eeprom.loads == 1);
+        REQUIRE(loader.primaryLoads() == 0);
+    }
+
+    SECTION("flash skill replaces a fallback load in progress") {
+        loader.begin(Command::Command(Simple::Rest), skill);
+        REQUIRE(loader.step() == false);
+        loader.begin(Command::Command(Simple::Sit), skill);
+        REQUIRE(loader.step() == true);
+        REQUIRE(skill.progmem);
+    }
+
+    SECTION("flash skills are not copied into the cache") {
+        Skill::LoaderCached cache(loader);
+        cache.load(Command::Command(Simple::Sit), skill);
+        REQUIRE(skill.spec == sit + 4);
+        REQUIRE(cache.used() == 0);
+        REQUIRE(cache.prefetch(Command::Command(Simple::Rest)));
+    }
+}
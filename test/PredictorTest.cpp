@@ -0,0 +1,87 @@
+//
+// Skill Predictor Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include "Arduino.h"
+
+#include "skill/Predictor.h"
+
+using namespace Command;
+
+static const Skill::Slot REST = Skill::slot(Simple::Rest);
+static const Skill::Slot BALANCE = Skill::slot(Simple::Balance);
+static const Skill::Slot GREET = Skill::slot(Simple::Greet);
+static const Skill::Slot SIT = Skill::slot(Simple::Sit);
+
+TEST_CASE("Predictor - nothing learned", "[Predictor]" ) 
+{
+    Skill::Predictor predictor;
+    REQUIRE(predictor.predict() == SKILL_SLOT_NONE);
+    predictor.observe(REST);
+    REQUIRE(predictor.last() == REST);
+    REQUIRE(predictor.predict() == SKILL_SLOT_NONE);
+}
+
+TEST_CASE("Predictor - learns a transition", "[Predictor]" ) 
+{
+    Skill::Predictor predictor;
+    predictor.observe(GREET);
+    predictor.observe(BALANCE);
+    predictor.observe(GREET);
+    REQUIRE(predictor.predict() == BALANCE);
+}
+
+TEST_CASE("Predictor - every slot fits its packed vote", "[Predictor]" ) 
+{
+    for (Skill::Slot from = 0; from < SKILL_SLOTS; from++) {
+        const Skill::Slot to = SKILL_SLOTS - 1 - from;
+        Skill::Predictor predictor;
+        for (uint8_t i = 0; i < PREDICTOR_MAX_CONFIDENCE + 2; i++) {
+            predictor.observe(from);
+            predictor.observe(to);
+        }
+        predictor.observe(from);
+        REQUIRE(predictor.predict() == to);
+    }
+}
+
+TEST_CASE("Predictor - ignores unknown slots", "[Predictor]" ) 
+{
+    Skill::Predictor predictor;
+    predictor.observe(GREET);
+    predictor.observe(SKILL_SLOT_NONE);
+    REQUIRE(predictor.last() == GREET);
+    predictor.observe(SKILL_SLOTS);
+    REQUIRE(predictor.last() == GREET);
+}
+
+TEST_CASE("Predictor - follows the majority", "[Predictor]" ) 
+{
+    Skill::Predictor predictor;
+    for (int i = 0; i < 3; i++) {
+        predictor.observe(REST);
+        predictor.observe(BALANCE);
+    }
+
+    SECTION("one off transition does not change the prediction") {
+        predictor.observe(REST);
+        predictor.observe(SIT);
+        predictor.observe(REST);
+        REQUIRE(predictor.predict() == BALANCE);
+    }
+
+    SECTION("persistent change takes over") {
+        for (int i = 0; i < PREDICTOR_MAX_CONFIDENCE + 1; i++) {
+            predictor.observe(REST);
+            predictor.observe(SIT);
+        }
+        predictor.observe(REST);
+        REQUIRE(predictor.predict() == SIT);
+    }
+}
@@ -0,0 +1,191 @@
+//
+// Command Queue Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include "Arduino.h"
+
+#include "command/Queue.h"
+
+using namespace Command;
+
+static const Command::Command WALK = Command::Command(Move{Pace::Medium, Direction::Forward});
+static const Command::Command TROT = Command::Command(Move{Pace::Fast, Direction::Forward});
+static const Command::Command SIT = Command::Command(Simple::Sit);
+static const Command::Command REST = Command::Command(Simple::Rest);
+static const Command::Command PAUSE = Command::Command(Simple::Pause);
+
+TEST_CASE("Queue order", "[Queue]" ) 
+{
+    Queue queue;
+    Command::Command cmd;
+    REQUIRE_FALSE(queue.pop(cmd));
+
+    SECTION("first in first out") {
+        REQUIRE(queue.push(WALK));
+        REQUIRE(queue.push(SIT));
+        REQUIRE(queue.push(TROT));
+        REQUIRE(queue.depth() == 3);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == WALK);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == SIT);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == TROT);
+        REQUIRE_FALSE(queue.pop(cmd));
+        REQUIRE(queue.depth() == 0);
+        REQUIRE(queue.maxDepth() == 3);
+    }
+
+    SECTION("empty commands are not queued") {
+        REQUIRE(queue.push(Command::Command()));
+        REQUIRE(queue.depth() == 0);
+    }
+
+    SECTION("wraps around") {
+        for (int i = 0; i < 300; i++) {
+            const Command::Command pushed = (i % 2) ? WALK : SIT;
+            REQUIRE(queue.push(pushed));
+            REQUIRE(queue.pop(cmd));
+            REQUIRE(cmd == pushed);
+        }
+        REQUIRE(queue.maxDepth() == 1);
+    }
+
+    SECTION("drops when full") {
+        for (int i = 0; i < COMMAND_QUEUE_SIZE; i++) {
+            REQUIRE(queue.push((i % 2) ? WALK : SIT));
+        }
+        REQUIRE_FALSE(queue.push(TROT));
+        REQUIRE(queue.drops() == 1);
+        REQUIRE(queue.depth() == COMMAND_QUEUE_SIZE);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == SIT);
+    }
+}
+
+TEST_CASE("Queue coalescing", "[Queue]" ) 
+{
+    Queue queue;
+    Command::Command cmd;
+
+    SECTION("repeats of the newest command collapse") {
+        queue.push(WALK);
+        queue.push(WALK);
+        queue.push(WALK);
+        REQUIRE(queue.depth() == 1);
+        REQUIRE(queue.coalesced() == 2);
+        REQUIRE(queue.drops() == 0);
+    }
+
+    SECTION("only the newest is compared") {
+        queue.push(WALK);
+        queue.push(SIT);
+        queue.push(WALK);
+        REQUIRE(queue.depth() == 3);
+    }
+
+    SECTION("a repeat after the command was taken is queued") {
+        queue.push(WALK);
+        queue.pop(cmd);
+        queue.push(WALK);
+        REQUIRE(queue.depth() == 1);
+    }
+}
+
+TEST_CASE("Queue priority", "[Queue]" ) 
+{
+    Queue queue;
+    Command::Command cmd;
+
+    REQUIRE(Queue::isPriority(REST));
+    REQUIRE(Queue::isPriority(PAUSE));
+    REQUIRE_FALSE(Queue::isPriority(SIT));
+
+    SECTION("rest jumps the queue and clears what was before it") {
+        queue.push(WALK);
+        queue.push(SIT);
+        queue.push(REST);
+        queue.push(TROT);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == REST);
+        REQUIRE(queue.drops() == 2);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == TROT);
+        REQUIRE_FALSE(queue.pop(cmd));
+    }
+
+    SECTION("does not take a slot") {
+        for (int i = 0; i < COMMAND_QUEUE_SIZE; i++) {
+            queue.push((i % 2) ? WALK : SIT);
+        }
+        REQUIRE(queue.push(PAUSE));
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == PAUSE);
+        REQUIRE(queue.depth() == 0);
+    }
+
+    SECTION("priority commands not yet taken all come out in order") {
+        queue.push(REST);
+        queue.push(PAUSE);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == REST);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == PAUSE);
+        REQUIRE_FALSE(queue.pop(cmd));
+        REQUIRE(queue.drops() == 0);
+    }
+
+    SECTION("a double pause before a pop is not coalesced") {
+        queue.push(PAUSE);
+        queue.push(PAUSE);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == PAUSE);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == PAUSE);
+        REQUIRE_FALSE(queue.pop(cmd));
+        REQUIRE(queue.coalesced() == 0);
+    }
+
+    SECTION("each priority command clears only what was queued before it") {
+        queue.push(PAUSE);
+        queue.push(SIT);
+        queue.push(PAUSE);
+        queue.push(WALK);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == PAUSE);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == PAUSE);
+        REQUIRE(queue.drops() == 1);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == WALK);
+        REQUIRE_FALSE(queue.pop(cmd));
+    }
+
+    SECTION("drops priority commands when their ring is full") {
+        for (int i = 0; i < COMMAND_PRIORITY_SIZE; i++) {
+            REQUIRE(queue.push(PAUSE));
+        }
+        REQUIRE_FALSE(queue.push(REST));
+        REQUIRE(queue.drops() == 1);
+        for (int i = 0; i < COMMAND_PRIORITY_SIZE; i++) {
+            REQUIRE(queue.pop(cmd));
+            REQUIRE(cmd == PAUSE);
+        }
+        REQUIRE_FALSE(queue.pop(cmd));
+    }
+
+    SECTION("taken once") {
+        queue.push(REST);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE_FALSE(queue.pop(cmd));
+        queue.push(SIT);
+        REQUIRE(queue.pop(cmd));
+        REQUIRE(cmd == SIT);
+    }
+}
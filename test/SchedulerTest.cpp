@@ -187,3 +187,57 @@ TEST_CASE("waitUntilNext", "[Scheduler]" )
         REQUIRE(TimeMock::currentUs == 600);
     }
 }
+
+static std::vector<uint32_t> idleSlack;
+static uint32_t idleWorkUs = 0;
+
+static void idleTask(uint32_t slackUs) {
+    idleSlack.push_back(slackUs);
+    TimeMock::currentUs += idleWorkUs;
+}
+
+TEST_CASE("idle task", "[Scheduler]" ) 
+{ 
+    TimeMock::reset();
+    idleSlack.clear();
+    idleWorkUs = 0;
+    Scheduler::Scheduler<1> s{};
+    int task = s.registerTask(100);
+    s.setIdleTask(idleTask);
+
+    SECTION("not called without slack"){
+        REQUIRE(task == s.waitUntilNextTask());
+        TimeMock::currentUs = 100;
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(idleSlack.empty());
+    }
+
+    SECTION("called with the slack before the next task"){
+        REQUIRE(task == s.waitUntilNextTask());
+        TimeMock::currentUs = 30;
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(idleSlack.size() == 1);
+        REQUIRE(idleSlack[0] == 70);
+        REQUIRE(TimeMock::currentUs == 100);
+    }
+
+    SECTION("idle work shortens the delay"){
+        idleWorkUs = 60;
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(TimeMock::totalDelayUs == 40);
+        REQUIRE(TimeMock::currentUs == 100);
+    }
+
+    SECTION("idle overrun keeps cadence"){
+        idleWorkUs = 150;
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(TimeMock::totalDelayUs == 0);
+        REQUIRE(TimeMock::currentUs == 150);
+
+        idleWorkUs = 0;
+        REQUIRE(task == s.waitUntilNextTask());
+        REQUIRE(TimeMock::currentUs == 200);
+    }
+}
@@ -0,0 +1,105 @@
+//
+// Skill Sequencer Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include "Arduino.h"
+
+#include "skill/Sequencer.h"
+
+using namespace Command;
+using Action = Skill::Sequencer::Action;
+
+static const Skill::Slot SIT = Skill::slot(Simple::Sit);
+static const Skill::Slot GREET = Skill::slot(Simple::Greet);
+static const Skill::Slot BALANCE = Skill::slot(Simple::Balance);
+static const Skill::Slot WALK = Skill::slot(Move{Pace::Medium, Direction::Forward});
+
+TEST_CASE("Sequencer setup", "[Sequencer]" ) 
+{
+    Skill::Sequencer sequencer;
+    REQUIRE_FALSE(sequencer.start());
+    REQUIRE_FALSE(sequencer.active());
+    REQUIRE(sequencer.tick(true) == Action::None);
+    REQUIRE(sequencer.current() == Command::Command());
+
+    SECTION("only playable skills") {
+        REQUIRE_FALSE(sequencer.add(Skill::slot(Simple::Pause), 10));
+        REQUIRE_FALSE(sequencer.add(Skill::slot(Simple::None), 10));
+        REQUIRE_FALSE(sequencer.add(SKILL_SLOT_CALIBRATE, 10));
+        REQUIRE_FALSE(sequencer.add(SKILL_SLOT_NONE, 10));
+        REQUIRE(sequencer.add(SIT, 10));
+        REQUIRE(sequencer.size() == 1);
+    }
+
+    SECTION("capacity") {
+        for (int i = 0; i < SEQUENCE_CAPACITY; i++) {
+            REQUIRE(sequencer.add(SIT, 10));
+        }
+        REQUIRE_FALSE(sequencer.add(SIT, 10));
+    }
+
+    SECTION("current and next") {
+        sequencer.add(SIT, 1);
+        sequencer.add(WALK, 1);
+        REQUIRE(sequencer.start());
+        REQUIRE(sequencer.current() == Command::Command(Simple::Sit));
+        REQUIRE(sequencer.next() == Command::Command(Move{Pace::Medium, Direction::Forward}));
+        REQUIRE(sequencer.tick(false) == Action::Start);
+        REQUIRE(sequencer.current() == Command::Command(Move{Pace::Medium, Direction::Forward}));
+        REQUIRE(sequencer.next() == Command::Command());
+    }
+}
+
+TEST_CASE("Sequencer playback", "[Sequencer]" ) 
+{
+    Skill::Sequencer sequencer;
+    sequencer.add(SIT, 3);
+    sequencer.add(GREET, 0, 2);
+    sequencer.add(BALANCE, 0);
+    sequencer.add(WALK, 2);
+    REQUIRE(sequencer.start());
+    REQUIRE(sequencer.index() == 0);
+
+    // Sit for exactly three ticks, cycles don't matter
+    REQUIRE(sequencer.tick(true) == Action::None);
+    REQUIRE(sequencer.tick(false) == Action::None);
+    REQUIRE(sequencer.tick(false) == Action::Start);
+    REQUIRE(sequencer.index() == 1);
+
+    // Greet twice
+    REQUIRE(sequencer.tick(false) == Action::None);
+    REQUIRE(sequencer.tick(true) == Action::None);
+    REQUIRE(sequencer.tick(false) == Action::None);
+    REQUIRE(sequencer.tick(true) == Action::Start);
+    REQUIRE(sequencer.index() == 2);
+
+    // Balance once by default
+    REQUIRE(sequencer.tick(false) == Action::None);
+    REQUIRE(sequencer.tick(true) == Action::Start);
+    REQUIRE(sequencer.index() == 3);
+
+    REQUIRE(sequencer.tick(false) == Action::None);
+    REQUIRE(sequencer.tick(false) == Action::Done);
+    REQUIRE_FALSE(sequencer.active());
+    REQUIRE(sequencer.tick(true) == Action::None);
+
+    SECTION("restart") {
+        REQUIRE(sequencer.start());
+        REQUIRE(sequencer.index() == 0);
+        REQUIRE(sequencer.tick(false) == Action::None);
+    }
+
+    SECTION("stop") {
+        REQUIRE(sequencer.start());
+        sequencer.stop();
+        REQUIRE(sequencer.tick(true) == Action::None);
+        REQUIRE(sequencer.tick(true) == Action::None);
+        REQUIRE(sequencer.tick(true) == Action::None);
+    }
+}
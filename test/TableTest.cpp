@@ -0,0 +1,148 @@
+//
+// Skill Table Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <set>
+#include <vector>
+
+#include "Arduino.h"
+
+#include "skill/Table.h"
+#include "skill/Index.h"
+
+using namespace Command;
+
+static std::string moveName(Pace pace, Direction direction) {
+    const std::vector<std::string> paces = {"cr", "wk", "tr", "bk"};
+    const std::vector<std::string> directions = {"F", "L", "R"};
+    if (pace == Pace::Reverse && direction == Direction::Forward) {
+        return "bk";
+    }
+    return paces[(int)pace] + directions[(int)direction];
+}
+
+TEST_CASE("Skill::slot - every move", "[Table]" ) 
+{
+    std::set<Skill::Slot> slots;
+    for (uint8_t p = 0; p < (uint8_t)Pace::TOTAL; p++) {
+        for (uint8_t d = 0; d < (uint8_t)Direction::TOTAL; d++) {
+            const Move move{(Pace)p, (Direction)d};
+            const std::string name = moveName(move.pace, move.direction);
+            SECTION(name) {
+                const Skill::Slot s = Skill::slot(Command::Command(move));
+                REQUIRE(s == Skill::slot(move));
+                REQUIRE(s < SKILL_MOVE_SLOTS);
+                REQUIRE(Skill::slotHash(s) == Skill::Index::hash(name.c_str()));
+            }
+            slots.insert(Skill::slot(move));
+        }
+    }
+    REQUIRE(slots.size() == SKILL_MOVE_SLOTS);
+}
+
+TEST_CASE("Skill::slot - every simple command", "[Table]" ) 
+{
+    struct TestCase {
+        Simple cmd;
+        const char* name;
+    };
+
+    const std::vector<TestCase> testCases = {
+        {Simple::None, NULL},
+        {Simple::Rest, "rest"},
+        {Simple::GyroToggle, NULL},
+        {Simple::Balance, "balance"},
+        {Simple::Pause, NULL},
+        {Simple::Step, "vt"},
+        {Simple::Sit, "sit"},
+        {Simple::Stretch, "str"},
+        {Simple::Greet, "hi"},
+        {Simple::Pushup, "pu"},
+        {Simple::Hydrant, "pee"},
+        {Simple::Check, "ck"},
+        {Simple::Dead, "pd"},
+        {Simple::Zero, "zero"},
+        {Simple::Lifted, "lifted"},
+        {Simple::Dropped, "dropped"},
+        {Simple::Recover, "rc"},
+        {Simple::SaveServoCalibration, NULL},
+        {Simple::AbortServoCalibration, NULL},
+        {Simple::ShowJointAngles, NULL},
+        {Simple::ShowHelp, NULL},
+    };
+    REQUIRE(testCases.size() == (size_t)Simple::TOTAL);
+
+    for (auto& tc : testCases) {
+        SECTION(std::to_string((int)tc.cmd)) {
+            const Skill::Slot s = Skill::slot(Command::Command(tc.cmd));
+            REQUIRE(s == Skill::slot(tc.cmd));
+            REQUIRE(s >= SKILL_MOVE_SLOTS);
+            REQUIRE(s < SKILL_SLOT_CALIBRATE);
+            char name[SKILL_NAME_SIZE];
+            if (tc.name == NULL) {
+                REQUIRE(Skill::slotHash(s) == SKILL_NO_HASH);
+                REQUIRE_FALSE(Skill::slotName(s, name));
+                REQUIRE(std::string(name) == "");
+            } else {
+                REQUIRE(Skill::slotHash(s) == Skill::Index::hash(tc.name));
+                REQUIRE(Skill::slotName(s, name));
+                REQUIRE(std::string(name) == tc.name);
+            }
+        }
+    }
+}
+
+TEST_CASE("Skill::slot - with args", "[Table]" ) 
+{
+    for (uint8_t a = 0; a < (uint8_t)ArgType::TOTAL; a++) {
+        const ArgType argType = (ArgType)a;
+        SECTION(std::to_string(a)) {
+            const Skill::Slot s = Skill::slot(Command::Command(WithArgs{argType, 0, {}}));
+            if (argType == ArgType::Calibrate) {
+                REQUIRE(s == SKILL_SLOT_CALIBRATE);
+                REQUIRE(Skill::slotHash(s) == Skill::Index::hash("calib"));
+            } else {
+                REQUIRE(s == SKILL_SLOT_NONE);
+            }
+        }
+    }
+}
+
+TEST_CASE("Skill::slot - none", "[Table]" ) 
+{
+    REQUIRE(Skill::slot(Command::Command()) == SKILL_SLOT_NONE);
+    REQUIRE(Skill::slotHash(SKILL_SLOT_NONE) == SKILL_NO_HASH);
+    REQUIRE(Skill::slotHash(SKILL_SLOTS) == SKILL_NO_HASH);
+    char name[SKILL_NAME_SIZE];
+    REQUIRE_FALSE(Skill::slotName(SKILL_SLOTS, name));
+}
+
+TEST_CASE("Skill::slotCommand - inverse of slot", "[Table]" ) 
+{
+    for (Skill::Slot s = 0; s < SKILL_SLOTS; s++) {
+        REQUIRE(Skill::slot(Skill::slotCommand(s)) == s);
+    }
+    REQUIRE(Skill::slotCommand(SKILL_SLOT_NONE).type() == Type::None);
+    REQUIRE(Skill::slotCommand(SKILL_SLOTS).type() == Type::None);
+}
+
+TEST_CASE("Skill::slotByName - inverse of slotName", "[Table]" ) 
+{
+    for (Skill::Slot s = 0; s < SKILL_SLOTS; s++) {
+        char name[SKILL_NAME_SIZE];
+        if (Skill::slotName(s, name)) {
+            REQUIRE(Skill::slotByName(name) == s);
+        }
+    }
+    REQUIRE(Skill::slotByName("") == SKILL_SLOT_NONE);
+    REQUIRE(Skill::slotByName("bk") == Skill::slot(Move{Pace::Reverse, Direction::Forward}));
+    REQUIRE(Skill::slotByName("b") == SKILL_SLOT_NONE);
+    REQUIRE(Skill::slotByName("bkLL") == SKILL_SLOT_NONE);
+    REQUIRE(Skill::slotByName("calibrate") == SKILL_SLOT_NONE);
+}
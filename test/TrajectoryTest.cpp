@@ -0,0 +1,173 @@
+//
+// Servo Trajectory Tests
+//
+// Hoani Bryson (github.com/hoani)
+// Copyright (c) 2021 Leetware Limited.
+// License - MIT
+//
+
+#include "catch.hpp"
+
+#include <math.h>
+#include <vector>
+
+#include "Arduino.h"
+
+#include "servo/Trajectory.h"
+
+static std::vector<std::vector<Servo::Angle>> runAll(Servo::Trajectory& trajectory) {
+    std::vector<std::vector<Servo::Angle>> steps;
+    Servo::Angle angles[DOF];
+    while (trajectory.step(angles)) {
+        steps.push_back(std::vector<Servo::Angle>(angles, angles + DOF));
+    }
+    return steps;
+}
+
+TEST_CASE("Trajectory steps", "[Trajectory]" ) 
+{
+    int16_t current[DOF] = {};
+    int8_t target[DOF] = {};
+    Servo::Trajectory trajectory;
+    REQUIRE_FALSE(trajectory.active());
+
+    SECTION("one degree per step by default") {
+        target[3] = 40;
+        target[7] = -10;
+        trajectory.begin(current, target);
+        REQUIRE(trajectory.active());
+        REQUIRE(trajectory.steps() == 40);
+        REQUIRE(runAll(trajectory).size() == 40);
+        REQUIRE_FALSE(trajectory.active());
+    }
+
+    SECTION("speed ratio") {
+        target[0] = 40;
+        trajectory.begin(current, target, 1, 4.0f);
+        REQUIRE(trajectory.steps() == 10);
+        trajectory.begin(current, target, 1, 0.5f);
+        REQUIRE(trajectory.steps() == 80);
+    }
+
+    SECTION("angle data ratio") {
+        target[0] = 40;
+        trajectory.begin(current, target, 2);
+        REQUIRE(trajectory.steps() == 80);
+        REQUIRE(runAll(trajectory).back()[0] == Servo::Angle::fromInt(80));
+    }
+
+    SECTION("zero speed ratio jumps") {
+        target[0] = 40;
+        trajectory.begin(current, target, 1, 0.0f);
+        std::vector<std::vector<Servo::Angle>> steps = runAll(trajectory);
+        REQUIRE(steps.size() == 1);
+        REQUIRE(steps[0][0] == Servo::Angle::fromInt(40));
+    }
+
+    SECTION("already there") {
+        trajectory.begin(current, target);
+        REQUIRE(runAll(trajectory).size() == 1);
+    }
+
+    SECTION("long moves are capped") {
+        target[0] = 120;
+        current[0] = -120;
+        trajectory.begin(current, target, 1, 0.5f);
+        REQUIRE(trajectory.steps() == TRAJECTORY_MAX_STEPS);
+    }
+
+    SECTION("offset joints only") {
+        int16_t gait[DOF - 8] = {};
+        for (uint8_t i = 0; i < DOF - 8; i++) {
+            gait[i] = 10 + i;
+        }
+        trajectory.begin(current, gait, 1, 1.0f, 8);
+        REQUIRE(trajectory.offset() == 8);
+        std::vector<std::vector<Servo::Angle>> steps = runAll(trajectory);
+        for (uint8_t i = 8; i < DOF; i++) {
+            REQUIRE(steps.back()[i] == Servo::Angle::fromInt(10 + i - 8));
+        }
+    }
+
+    SECTION("stop") {
+        target[0] = 40;
+        trajectory.begin(current, target);
+        Servo::Angle angles[DOF];
+        REQUIRE(trajectory.step(angles));
+        REQUIRE(trajectory.remaining() == 39);
+        trajectory.stop();
+        REQUIRE_FALSE(trajectory.active());
+        REQUIRE_FALSE(trajectory.step(angles));
+    }
+
+    SECTION("timed steps keep the pace of the blocking loop") {
+        target[0] = 40;
+        trajectory.begin(current, target);
+        Servo::Angle angles[DOF];
+        const uint32_t start = 0xFFFFF000UL; // micros() wraps during the move
+        REQUIRE(trajectory.step(angles, start));
+        REQUIRE(trajectory.remaining() == 39);
+        REQUIRE_FALSE(trajectory.step(angles, start + TRAJECTORY_STEP_MICROS - 1));
+        REQUIRE(trajectory.remaining() == 39);
+
+        // One 20ms motion tick covers eight steps
+        REQUIRE(trajectory.step(angles, start + 20000));
+        REQUIRE(trajectory.remaining() == 31);
+
+        REQUIRE(trajectory.step(angles, start + 39 * TRAJECTORY_STEP_MICROS));
+        REQUIRE_FALSE(trajectory.active());
+        REQUIRE(angles[0] == Servo::Angle::fromInt(40));
+        REQUIRE_FALSE(trajectory.step(angles, start + 40 * TRAJECTORY_STEP_MICROS));
+    }
+
+    SECTION("a late tick goes straight to the target") {
+        target[0] = 40;
+        trajectory.begin(current, target);
+        Servo::Angle angles[DOF];
+        REQUIRE(trajectory.step(angles, 1000));
+        REQUIRE(trajectory.step(angles, 1000000));
+        REQUIRE_FALSE(trajectory.active());
+        REQUIRE(angles[0] == Servo::Angle::fromInt(40));
+    }
+}
+
+TEST_CASE("Trajectory easing", "[Trajectory]" ) 
+{
+    int16_t current[DOF] = {};
+    int8_t target[DOF] = {};
+    for (uint8_t i = 0; i < DOF; i++) {
+        current[i] = -60 + 8 * i;
+        target[i] = 70 - 9 * i;
+    }
+    Servo::Trajectory trajectory;
+    trajectory.begin(current, target, 1, 1.5f);
+    const uint8_t steps = trajectory.steps();
+    std::vector<std::vector<Servo::Angle>> angles = runAll(trajectory);
+
+    SECTION("matches the float cosine ease") {
+        for (uint8_t s = 1; s <= steps; s++) {
+            const float ease = (1 + cos(M_PI * s / steps)) / 2;
+            for (uint8_t i = 0; i < DOF; i++) {
+                const float expected = target[i] + ease * (current[i] - target[i]);
+                // Table ease error, plus the angle resolution
+                const float tolerance = 3e-4f * abs(current[i] - target[i]) + 2.0f / (1 << SERVO_ANGLE_BITS);
+                REQUIRE(fabs(angles[s - 1][i].toF32() - expected) < tolerance);
+            }
+        }
+    }
+
+    SECTION("monotonic and ends on target") {
+        for (uint8_t i = 0; i < DOF; i++) {
+            Servo::Angle last = Servo::Angle::fromInt(current[i]);
+            for (uint8_t s = 0; s < steps; s++) {
+                if (target[i] > current[i]) {
+                    REQUIRE(angles[s][i] >= last);
+                } else {
+                    REQUIRE(angles[s][i] <= last);
+                }
+                last = angles[s][i];
+            }
+            REQUIRE(last == Servo::Angle::fromInt(target[i]));
+        }
+    }
+}
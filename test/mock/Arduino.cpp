@@ -18,4 +18,46 @@ void delayMicroseconds(uint16_t us){
     TimeMock::lastDelayUs = us;
     TimeMock::totalDelayUs += us;
     TimeMock::currentUs += us;
-}
\ No newline at end of file
+    InterruptMock::fireScheduled();
+}
+void (*InterruptMock::handlers[INTERRUPT_MOCK_COUNT])(void) = {};
+int InterruptMock::modes[INTERRUPT_MOCK_COUNT] = {};
+bool InterruptMock::scheduled[INTERRUPT_MOCK_COUNT] = {};
+uint32_t InterruptMock::scheduledUs[INTERRUPT_MOCK_COUNT] = {};
+
+void InterruptMock::reset(){
+    for (uint8_t i = 0; i < INTERRUPT_MOCK_COUNT; i++) {
+        handlers[i] = NULL;
+        modes[i] = 0;
+        scheduled[i] = false;
+    }
+}
+
+void InterruptMock::trigger(uint8_t interrupt){
+    if ((interrupt < INTERRUPT_MOCK_COUNT) && (handlers[interrupt] != NULL)) {
+        handlers[interrupt]();
+    }
+}
+
+void InterruptMock::schedule(uint8_t interrupt, uint32_t us){
+    scheduled[interrupt] = true;
+    scheduledUs[interrupt] = us;
+}
+
+void InterruptMock::fireScheduled(){
+    for (uint8_t i = 0; i < INTERRUPT_MOCK_COUNT; i++) {
+        if (scheduled[i] && (TimeMock::currentUs >= scheduledUs[i])) {
+            scheduled[i] = false;
+            trigger(i);
+        }
+    }
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(void), int mode){
+    InterruptMock::handlers[interrupt] = handler;
+    InterruptMock::modes[interrupt] = mode;
+}
+
+void detachInterrupt(uint8_t interrupt){
+    InterruptMock::handlers[interrupt] = NULL;
+}
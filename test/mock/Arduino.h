@@ -19,6 +19,11 @@
 
 #define F(s) (s)
 
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_ptr(addr) (*(void* const*)(addr))
+
 #define min(a,b) std::min(a,b)
 #define abs(a) std::abs(a)
 
@@ -36,5 +41,24 @@ public:
 uint32_t micros();
 void delayMicroseconds(uint16_t us);
 
+#define RISING 3
+#define INTERRUPT_MOCK_COUNT 2
+
+// Stands in for the external interrupt pins, so tests can fire a handler as the hardware would.
+class InterruptMock{
+public:
+    static void reset();
+    static void trigger(uint8_t interrupt);
+    static void schedule(uint8_t interrupt, uint32_t us); // Fires once a delay reaches us
+    static void fireScheduled();
+    static void (*handlers[INTERRUPT_MOCK_COUNT])(void);
+    static int modes[INTERRUPT_MOCK_COUNT];
+    static bool scheduled[INTERRUPT_MOCK_COUNT];
+    static uint32_t scheduledUs[INTERRUPT_MOCK_COUNT];
+};
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+
 
 # endif // _BITTLEET_MOCK_ARDUINO_H_
\ No newline at end of file
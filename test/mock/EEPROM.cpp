@@ -16,3 +16,10 @@ int16_t EEPROMMock::read(int16_t address) const {
     return (address < 1024) ? data[address] : -1;
 }
 
+
+void EEPROMMock::update(int16_t address, uint8_t value) {
+    if ((address < 1024) && (data[address] != (int8_t)value)) {
+        data[address] = (int8_t)value;
+        writes++;
+    }
+}
@@ -12,12 +12,16 @@
 
 #include <stdint.h>
 #include <vector>
+#include <cstddef>
 
 class EEPROMMock {
 public:
     EEPROMMock() = default;
 
     int16_t read(int16_t address) const;
+    void update(int16_t address, uint8_t value);
+
+    size_t writes = 0;
 
     std::vector<int8_t> data = std::vector<int8_t>(1024, 0x00);
 };
@@ -16,6 +16,7 @@ WireMock Wire = WireMock();
 
 void WireMock::beginTransmission(int16_t address) {
     writeAddress = address;
+    _transmissionStart = writeBuffer.size();
 }
 
 int16_t WireMock::write(uint8_t byte) {
@@ -24,12 +25,17 @@ int16_t WireMock::write(uint8_t byte) {
 }
 
 int16_t WireMock::endTransmission() {
+    transmissions++;
+    if (!eeprom.empty() && (writeBuffer.size() - _transmissionStart) >= 2) {
+        eepromAddress = ((size_t)writeBuffer[_transmissionStart] << 8) | writeBuffer[_transmissionStart + 1];
+    }
     return 0;
 }
 
 int16_t WireMock::requestFrom(int16_t address, int16_t quantity) {
     requestedAddress = address;
     requestedQuantity = quantity;
+    requests.push_back(quantity);
     availableToRead = quantity; //std::min(quantity, (int16_t)((int32_t)readBuffer.size() - (int32_t)readIndex));
     return availableToRead;
 }
@@ -37,6 +43,10 @@ int16_t WireMock::requestFrom(int16_t address, int16_t quantity) {
 int16_t WireMock::read() {
     if (availableToRead != 0) {
         availableToRead--;
+        bytesRead++;
+        if (!eeprom.empty()) {
+            return eeprom[eepromAddress++ % eeprom.size()];
+        }
         return readBuffer[readIndex++];
     }
     return -1;
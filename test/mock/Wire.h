@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 #include <vector>
+#include <cstddef>
 
 class WireMock {
 public:
@@ -32,6 +33,18 @@ public:
     std::vector<int8_t> readBuffer;
     size_t readIndex = 0;
     size_t availableToRead = 0;
+
+    // When populated, reads come from here and the first two bytes of each transmission
+    // set the read address - like a 16 bit addressed I2C EEPROM.
+    std::vector<int8_t> eeprom;
+    size_t eepromAddress = 0;
+
+    size_t transmissions = 0;
+    std::vector<int16_t> requests;
+    size_t bytesRead = 0;
+
+private:
+    size_t _transmissionStart = 0;
 };
 
 extern WireMock Wire;